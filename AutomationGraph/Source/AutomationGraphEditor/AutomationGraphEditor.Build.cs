@@ -84,8 +84,11 @@ public class AutomationGraphEditor : ModuleRules
 				"AssetTools",
 				"AssetRegistry",
 				"AutomationController",
+				"DirectoryWatcher",
 				"EditorSubsystem",
 				"GameProjectGeneration",
+				"Json",
+				"JsonUtilities",
 				"KismetWidgets",
 				"ToolMenus",
 				"UMG",
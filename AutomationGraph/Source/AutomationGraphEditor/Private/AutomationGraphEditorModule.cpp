@@ -34,8 +34,13 @@
 #include "AssetToolsModule.h"
 #include "AutomationGraphEditorLoggingDefs.h"
 #include "EdGraphUtilities.h"
+#include "Editor.h"
+#include "AutomationNodes/RunTests.h"
 #include "Boilerplate/AutomationGraphNodeFactory.h"
+#include "Foundation/AutomationGraphBuilder.h"
+#include "Subsystems/AssetEditorSubsystem.h"
 #include "Logging/LogMacros.h"
+#include "Misc/CoreDelegates.h"
 #include "Styles/AutomationGraphEditorStyle.h"
 
 #define LOCTEXT_NAMESPACE "FAutomationGraphEditorModule"
@@ -55,6 +60,17 @@ void FAutomationGraphEditorModule::StartupModule()
 		FName(TEXT("Automation Graph")), // pretty sure this needs to match the display name exactly, because of the new AssetDefinition system
 		NSLOCTEXT("AssetTypeActions", "AutomationGraphCategory", "Automation Graph")
 	);
+
+	EngineLoopInitCompleteHandle = FCoreDelegates::OnFEngineLoopInitComplete.AddStatic(&UAGN_RunTests::QueueWorkerTests);
+
+	// An open editor would keep showing (and writing back) the editor graph that the builder discards.
+	GraphRebuildingHandle = FAutomationGraphBuilder::OnGraphRebuilding.AddLambda([](UAutomationGraph* Graph)
+	{
+		if (GEditor)
+		{
+			GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->CloseAllEditorsForAsset(Graph);
+		}
+	});
 }
 
 void FAutomationGraphEditorModule::ShutdownModule()
@@ -62,6 +78,10 @@ void FAutomationGraphEditorModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 	UE_LOG(LogAutoGraphEditor, Log, TEXT("Shutting down AutomationGraphEditorModule."));
+
+	FCoreDelegates::OnFEngineLoopInitComplete.Remove(EngineLoopInitCompleteHandle);
+	FAutomationGraphBuilder::OnGraphRebuilding.Remove(GraphRebuildingHandle);
+	UAGN_RunTests::StopTrackingTestListChanges();
 	
 	if (AGNodeFactory.IsValid())
 	{
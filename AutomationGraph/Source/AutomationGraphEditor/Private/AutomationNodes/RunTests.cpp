@@ -34,8 +34,87 @@
 #include "AutomationControllerSettings.h"
 #include "AutomationGraphEditorLoggingDefs.h"
 #include "AutomationGroupFilter.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Foundation/AutomationGraphResultCache.h"
+#include "Foundation/AutomationGraphTestHistory.h"
+#include "Foundation/AutomationGraphTestImpact.h"
+#include "HAL/FileManager.h"
+#include "IAutomationReport.h"
 #include "Macros/AutomationGraphLoggingMacros.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 #include "Subsystems/AutomationGraphSubsystem.h"
+#include "UObject/UObjectGlobals.h"
+
+const FName UAGN_RunTests::TestsInputName = TEXT("Tests");
+const FName UAGN_RunTests::FailedTestsOutputName = TEXT("FailedTests");
+
+namespace
+{
+	// Test workers read their tests from this file rather than from -ExecCmds, which splits its commands on commas.
+	const TCHAR* WorkerTestListSwitch = TEXT("AutomationGraphTestList=");
+
+	FString GetWorkerExecutablePath()
+	{
+#if PLATFORM_WINDOWS
+		return FPlatformProcess::GenerateApplicationPath(TEXT("UnrealEditor-Cmd"), FApp::GetBuildConfiguration());
+#else
+		return FPlatformProcess::GenerateApplicationPath(TEXT("UnrealEditor"), FApp::GetBuildConfiguration());
+#endif
+	}
+
+	// Bumped whenever modules are loaded, unloaded, or reloaded, since that is when the set of registered tests changes.
+	// The delegates are bound on first use and removed by UAGN_RunTests::StopTrackingTestListChanges().
+	uint32 TestListVersion = 0;
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	
+	uint32 GetTestListVersion()
+	{
+		if (!ModulesChangedHandle.IsValid())
+		{
+			ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([](FName, EModuleChangeReason) { ++TestListVersion; });
+			ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason) { ++TestListVersion; });
+		}
+
+		return TestListVersion;
+	}
+
+	// GetValidTestNames() only returns tests that match the framework's requested filter, which is whatever the last test
+	// run left behind (nothing, if no tests have run yet). Ask for every type of test and let the node's filters decide.
+	void GetAllValidTests(TArray<FAutomationTestInfo>& OutTestInfos)
+	{
+		FAutomationTestFramework& TestFramework = FAutomationTestFramework::Get();
+		const uint32 PreviousTestFilter = TestFramework.GetRequestedTestFilter();
+		TestFramework.SetRequestedTestFilter(EAutomationTestFlags::FilterMask);
+		TestFramework.GetValidTestNames(OutTestInfos);
+		TestFramework.SetRequestedTestFilter(PreviousTestFilter);
+	}
+
+	bool PassesFilter(const FString& TestPath, const FAutomatedTestFilter& Filter)
+	{
+		if (Filter.MatchFromStart && Filter.MatchFromEnd)
+		{
+			return TestPath.Equals(Filter.Contains);
+		}
+		if (Filter.MatchFromStart)
+		{
+			return TestPath.StartsWith(Filter.Contains);
+		}
+		if (Filter.MatchFromEnd)
+		{
+			return TestPath.EndsWith(Filter.Contains);
+		}
+		
+		return TestPath.Contains(Filter.Contains);
+	}
+}
 
 bool UAGN_RunTests::Initialize(UWorld* World)
 {
@@ -45,9 +124,18 @@ bool UAGN_RunTests::Initialize(UWorld* World)
 	}
 	
 	TestState = ETestState::Idle;
-	FindWorkersTimerSec = 0.0f;
-	FindWorkersAttemtps = 0;
+	FindWorkersElapsedSec = 0.0f;
+	FindWorkersRetrySec = 0.0f;
+	FindWorkersBackoffSec = FindWorkersInitialBackoffSec;
+	FindWorkersRequests = 0;
 	AutomationController = nullptr;
+	RequestedTests.Empty();
+	TestDependencyHashes.Empty();
+	TestBatches.Empty();
+	NextTestBatch = 0;
+	NumFailedTests = 0;
+	StreamedTests.Empty();
+	TerminateShards();
 
 	SessionID = FApp::GetSessionId();
 	
@@ -56,17 +144,56 @@ bool UAGN_RunTests::Initialize(UWorld* World)
 
 void UAGN_RunTests::Cleanup()
 {
+	TerminateShards();
+	ResultsWriter.Close();
+	
 	if (AutomationController.IsValid())
 	{
 		if (auto* AGSubsystem = GEditor->GetEditorSubsystem<UAutomationGraphSubsystem>())
 		{
-			AutomationController->OnTestsRefreshed().RemoveAll(this);
+			UnbindControllerEvents();
 			AGSubsystem->ReleaseAutomationController(this);
 			AutomationController = nullptr;
 		}
 	}
 }
 
+void UAGN_RunTests::GetInputSlots(TArray<FAutomationGraphDataSlot>& OutSlots)
+{
+	OutSlots.Emplace(TestsInputName, FAutomationGraphStringList::StaticStruct());
+}
+
+void UAGN_RunTests::GetOutputSlots(TArray<FAutomationGraphDataSlot>& OutSlots)
+{
+	OutSlots.Emplace(FailedTestsOutputName, FAutomationGraphStringList::StaticStruct());
+}
+
+FString UAGN_RunTests::GetMessageText()
+{
+	const FString StateMessage = Super::GetMessageText();
+	if (ResolvedTestsKey.IsEmpty())
+	{
+		return StateMessage;
+	}
+
+	const FString TestCountMessage = FString::Printf(TEXT("%d tests"), ResolvedTestNames.Num());
+	return StateMessage.IsEmpty() ? TestCountMessage : FString::Printf(TEXT("%s (%s)"), *StateMessage, *TestCountMessage);
+}
+
+void UAGN_RunTests::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Resolve the tests up front so the node can show how many will run. Tests passed in from upstream aren't known
+	// until the graph runs.
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, Tests) && GetState() != EAutomationGraphNodeState::Active)
+	{
+		RequestedTests = Tests;
+		TArray<FString> TestNames;
+		GenerateLocalTestNames(TestNames);
+	}
+}
+
 void UAGN_RunTests::TestsReady()
 {
 	if (AutomationController->GetNumDeviceClusters() == 0 || TestState != ETestState::WaitForTestsReady)
@@ -74,20 +201,41 @@ void UAGN_RunTests::TestsReady()
 		return;
 	}
 
+	if (FAutomationGraphStringList* FailedTests = WriteOutput<FAutomationGraphStringList>(FailedTestsOutputName))
+	{
+		FailedTests->Values.Reset();
+	}
+
+	// The controller's list depends on which workers answered, so describe them as well as the version. This is checked
+	// before touching the controller's filters, which walk every test the workers reported.
+	FString TestListVersion = FString::Printf(TEXT("Controller:%u"), GetTestListVersion());
+	for (int32 ClusterIndex = 0; ClusterIndex < AutomationController->GetNumDeviceClusters(); ++ClusterIndex)
+	{
+		TestListVersion += FString::Printf(TEXT(":%s:%d"), *AutomationController->GetDeviceTypeName(ClusterIndex), AutomationController->GetNumDevicesInCluster(ClusterIndex));
+	}
+	
 	TArray<FString> FilteredTestNames;
-	TSharedPtr <AutomationFilterCollection> AutomationFilters = MakeShareable(new AutomationFilterCollection());
-	AutomationController->SetFilter(AutomationFilters);
-	AutomationController->SetVisibleTestsEnabled(true);
-	AutomationController->GetEnabledTestNames(FilteredTestNames);
+	const FString TestsKey = MakeResolvedTestsKey(TestListVersion);
+	if (TestsKey == ResolvedTestsKey)
+	{
+		FilteredTestNames = ResolvedTestNames;
+	}
+	else
+	{
+		TSharedPtr <AutomationFilterCollection> AutomationFilters = MakeShareable(new AutomationFilterCollection());
+		AutomationController->SetFilter(AutomationFilters);
+		AutomationController->SetVisibleTestsEnabled(true);
+		GenerateTestNames(AutomationFilters, FilteredTestNames);
+		ResolvedTestsKey = TestsKey;
+		ResolvedTestNames = FilteredTestNames;
+	}
 
-	GenerateTestNames(AutomationFilters, FilteredTestNames);
+	SelectImpactedTests(FilteredTestNames);
+	BuildTestBatches(FilteredTestNames);
 
-	if (FilteredTestNames.Num())
+	if (TestBatches.Num())
 	{
-		AutomationController->StopTests();
-		AutomationController->SetEnabledTests(FilteredTestNames);
-		AutomationController->RunTests();
-		
+		StartNextTestBatch();
 		TestState = ETestState::RunningTests;
 	}
 	else
@@ -96,6 +244,14 @@ void UAGN_RunTests::TestsReady()
 	}
 }
 
+void UAGN_RunTests::WorkersReady(EAutomationControllerModuleState::Type ControllerState)
+{
+	if (ControllerState == EAutomationControllerModuleState::Ready)
+	{
+		TestsReady();
+	}
+}
+
 EAutomationGraphNodeState UAGN_RunTests::ActivateInternal(float DeltaSeconds)
 {
 	// Standard activation, ensures the node is active past this block.
@@ -115,11 +271,53 @@ EAutomationGraphNodeState UAGN_RunTests::ActivateInternal(float DeltaSeconds)
 
 	if (TestState == ETestState::Idle)
 	{
-		if (Tests.IsEmpty())
+		RequestedTests = Tests;
+		if (const FAutomationGraphStringList* InputTests = ReadInput<FAutomationGraphStringList>(TestsInputName))
+		{
+			RequestedTests.Append(InputTests->Values);
+		}
+
+		// Always start new reports, even if no tests end up running, so that results from a previous run aren't mistaken
+		// for this one's.
+		OpenResults();
+		
+		if (RequestedTests.IsEmpty())
 		{
 			TestState = ETestState::Complete;
 			UpdatedNodeState = EAutomationGraphNodeState::Finished;
 		}
+		else if (NumLocalWorkers > 0)
+		{
+			TArray<FString> TestNames;
+			GenerateLocalTestNames(TestNames);
+			SelectImpactedTests(TestNames);
+			BuildShards(TestNames);
+
+			// Workers report as they finish, start with an empty list so downstream nodes only see this run's failures.
+			if (FAutomationGraphStringList* FailedTests = WriteOutput<FAutomationGraphStringList>(FailedTestsOutputName))
+			{
+				FailedTests->Values.Reset();
+			}
+
+			for (int32 ShardIndex = 0; ShardIndex < Shards.Num(); ++ShardIndex)
+			{
+				if (!LaunchShard(Shards[ShardIndex], ShardIndex))
+				{
+					TerminateShards();
+					return SetState(EAutomationGraphNodeState::Error);
+				}
+			}
+
+			if (Shards.IsEmpty())
+			{
+				TestState = ETestState::Complete;
+				UpdatedNodeState = EAutomationGraphNodeState::Finished;
+			}
+			else
+			{
+				TestState = ETestState::RunningShards;
+			}
+		}
 		else
 		{
 			TestState = ETestState::WaitForController;	
@@ -135,35 +333,98 @@ EAutomationGraphNodeState UAGN_RunTests::ActivateInternal(float DeltaSeconds)
 		if (AutomationController.IsValid())
 		{
 			TestState = ETestState::WaitForTestsReady;
+			BindControllerEvents();
+			RequestWorkers();
 		}
 	}
 	else if (TestState == ETestState::WaitForTestsReady)
 	{
-		// We have to check this every time because if the user has the test automation window open and then they
-		// close it, this causes all delegates to be removed from the AutomationController.
-		if (!AutomationController->OnTestsRefreshed().IsBoundToObject(this))
+		// Workers answer through the controller's events, this only handles retries and giving up.
+		FindWorkersElapsedSec += DeltaSeconds;
+		FindWorkersRetrySec += DeltaSeconds;
+
+		if (FindWorkersElapsedSec >= FindWorkersTimeoutSec)
 		{
-			AutomationController->OnTestsRefreshed().AddUObject(this, &ThisClass::TestsReady);
+			AG_LOG_OBJECT(this, LogAutoGraphEditor, Error, TEXT("%s"), *DescribeMissingWorkers());
+			return SetState(EAutomationGraphNodeState::Expired);
 		}
 
-		FindWorkersTimerSec += DeltaSeconds;
+		if (FindWorkersRetrySec >= FindWorkersBackoffSec)
+		{
+			RequestWorkers();
+		}
+	}
+	else if (TestState == ETestState::RunningTests)
+	{
+		StreamCompletedReports();
 		
-		if (FindWorkersAttemtps == 0 || FindWorkersTimerSec >= FindWorkersTimeoutSec)
+		if (ShouldFailFast(NumFailedTests + CountFailedReports()))
 		{
-			FindWorkersAttemtps++;
-			if (FindWorkersAttemtps > MaxFindWorkersAttempts)
+			AutomationController->StopTests();
+			WriteFailedTests();
+			AG_LOG_OBJECT(this, LogAutoGraphEditor, Error, TEXT("Stopped testing after %d failed tests"), NumFailedTests);
+
+			const FString SkipReason = FString::Printf(TEXT("Testing stopped after %d failed tests"), NumFailedTests);
+			FlushBatchReports(SkipReason);
+			for (int32 BatchIndex = NextTestBatch; BatchIndex < TestBatches.Num(); ++BatchIndex)
 			{
-				return SetState(EAutomationGraphNodeState::Expired);
+				WriteSkippedTests(TestBatches[BatchIndex], SkipReason);
 			}
 			
-			AutomationController->RequestAvailableWorkers(SessionID);
-			FindWorkersTimerSec = 0;
+			TestState = ETestState::Complete;
+			UpdatedNodeState = EAutomationGraphNodeState::Error;
+		}
+		else if (AutomationController->GetTestState() != EAutomationControllerModuleState::Running)
+		{
+			FlushBatchReports(TEXT("Did not run"));
+			WriteFailedTests();
+			if (NextTestBatch < TestBatches.Num())
+			{
+				StartNextTestBatch();
+			}
+			else
+			{
+				TestState = ETestState::Complete;
+				UpdatedNodeState = EAutomationGraphNodeState::Finished;
+			}
 		}
 	}
-	else if (TestState == ETestState::RunningTests)
+	else if (TestState == ETestState::RunningShards)
 	{
-		if (AutomationController->GetTestState() != EAutomationControllerModuleState::Running)
+		// Merge each worker's results as soon as it exits, so that fail fast doesn't have to wait for the slowest one.
+		bool bAnyRunning = false;
+		for (int32 ShardIndex = 0; ShardIndex < Shards.Num(); ++ShardIndex)
 		{
+			FTestShard& Shard = Shards[ShardIndex];
+			if (Shard.Process.IsValid() && FPlatformProcess::IsProcRunning(Shard.Process))
+			{
+				bAnyRunning = true;
+			}
+			else if (!Shard.bMerged)
+			{
+				MergeShardResult(Shard, ShardIndex);
+			}
+		}
+
+		if (ShouldFailFast(NumFailedTests))
+		{
+			const FString SkipReason = FString::Printf(TEXT("Testing stopped after %d failed tests"), NumFailedTests);
+			for (const FTestShard& Shard : Shards)
+			{
+				if (!Shard.bMerged)
+				{
+					WriteSkippedTests(Shard.Tests, SkipReason);
+				}
+			}
+			
+			TerminateShards();
+			AG_LOG_OBJECT(this, LogAutoGraphEditor, Error, TEXT("Stopped testing after %d failed tests"), NumFailedTests);
+			TestState = ETestState::Complete;
+			UpdatedNodeState = EAutomationGraphNodeState::Error;
+		}
+		else if (!bAnyRunning)
+		{
+			TerminateShards();
 			TestState = ETestState::Complete;
 			UpdatedNodeState = EAutomationGraphNodeState::Finished;
 		}
@@ -177,6 +438,17 @@ EAutomationGraphNodeState UAGN_RunTests::ActivateInternal(float DeltaSeconds)
 		UpdatedNodeState = EAutomationGraphNodeState::Error;
 	}
 
+	if (UpdatedNodeState == EAutomationGraphNodeState::Finished)
+	{
+		// Make sure downstream nodes always see the output, even if no tests ran.
+		WriteOutput<FAutomationGraphStringList>(FailedTestsOutputName);
+	}
+
+	if (UpdatedNodeState != EAutomationGraphNodeState::Active)
+	{
+		ResultsWriter.Close();
+	}
+
 	if (UpdatedNodeState != GetState())
 	{
 		SetState(UpdatedNodeState);
@@ -185,6 +457,64 @@ EAutomationGraphNodeState UAGN_RunTests::ActivateInternal(float DeltaSeconds)
 	return UpdatedNodeState;
 }
 
+void UAGN_RunTests::BindControllerEvents()
+{
+	if (!AutomationController->OnTestsRefreshed().IsBoundToObject(this))
+	{
+		AutomationController->OnTestsRefreshed().AddUObject(this, &ThisClass::TestsReady);
+	}
+	if (!AutomationController->OnTestsAvailable().IsBoundToObject(this))
+	{
+		AutomationController->OnTestsAvailable().AddUObject(this, &ThisClass::WorkersReady);
+	}
+}
+
+void UAGN_RunTests::UnbindControllerEvents()
+{
+	AutomationController->OnTestsRefreshed().RemoveAll(this);
+	AutomationController->OnTestsAvailable().RemoveAll(this);
+}
+
+void UAGN_RunTests::RequestWorkers()
+{
+	FindWorkersRetrySec = 0.0f;
+
+	// RequestAvailableWorkers() resets the controller's worker list, so don't interrupt a worker that is partway
+	// through sending its tests.
+	if (FindWorkersRequests > 0 && AutomationController->GetNumDeviceClusters() > 0)
+	{
+		return;
+	}
+
+	// Closing the test automation window removes every delegate from the controller, so rebind before each request.
+	BindControllerEvents();
+	
+	AutomationController->RequestAvailableWorkers(SessionID);
+	FindWorkersRequests++;
+	FindWorkersBackoffSec = FMath::Min(FindWorkersInitialBackoffSec * FMath::Pow(2.0f, static_cast<float>(FindWorkersRequests - 1)), FindWorkersMaxBackoffSec);
+}
+
+FString UAGN_RunTests::DescribeMissingWorkers() const
+{
+	const int32 NumClusters = AutomationController->GetNumDeviceClusters();
+	if (NumClusters > 0)
+	{
+		return FString::Printf(TEXT("Found %d automation worker group(s) but none sent a test list within %.0f sec."), NumClusters, FindWorkersTimeoutSec);
+	}
+
+	FString Description = FString::Printf(TEXT("No automation workers answered within %.0f sec (%d requests for session %s)."), FindWorkersTimeoutSec, FindWorkersRequests, *SessionID.ToString());
+	if (!FModuleManager::Get().IsModuleLoaded(TEXT("AutomationWorker")))
+	{
+		Description += TEXT(" The AutomationWorker module is not loaded in this editor, so it can't run tests itself.");
+	}
+	else
+	{
+		Description += TEXT(" Workers only answer if they belong to this editor's session.");
+	}
+	
+	return Description;
+}
+
 void UAGN_RunTests::GenerateTestNames(TSharedPtr<AutomationFilterCollection> InFilters, TArray<FString>& OutFilteredTestNames)
 {
 	// This fn is basically 1:1 with FAutomationExecCmd::GenerateTestNamesFromCommandLine(). See AutomationCommandline.cpp
@@ -192,6 +522,47 @@ void UAGN_RunTests::GenerateTestNames(TSharedPtr<AutomationFilterCollection> InF
 	
 	OutFilteredTestNames.Empty();
 
+	TArray<FAutomatedTestFilter> FiltersList;
+	GenerateTestFilters(FiltersList);
+
+	if (!FiltersList.IsEmpty())
+	{
+		FAutomationGroupFilter* FilterAny = new FAutomationGroupFilter();
+		FilterAny->SetFilters(FiltersList);
+		InFilters->Add(MakeShareable(FilterAny));
+
+		// SetFilter applies all filters from the AutomationFilters array
+		AutomationController->SetFilter(InFilters);
+		// Fill OutFilteredTestNames array with filtered test names
+		AutomationController->GetFilteredTestNames(OutFilteredTestNames);
+	}
+}
+
+FString UAGN_RunTests::MakeResolvedTestsKey(const FString& TestListVersion) const
+{
+	FAutomationGraphCacheInputs Inputs;
+	Inputs.AddString(TestListVersion);
+	
+	for (const FString& TestName : RequestedTests)
+	{
+		Inputs.AddString(TestName);
+	}
+
+	const UAutomationControllerSettings* Settings = GetDefault<UAutomationControllerSettings>();
+	for (const FAutomatedTestGroup& Group : Settings->Groups)
+	{
+		Inputs.AddString(Group.Name);
+		for (const FAutomatedTestFilter& Filter : Group.Filters)
+		{
+			Inputs.AddString(FString::Printf(TEXT("%s:%d:%d"), *Filter.Contains, Filter.MatchFromStart, Filter.MatchFromEnd));
+		}
+	}
+
+	return Inputs.Finalize();
+}
+
+void UAGN_RunTests::GenerateTestFilters(TArray<FAutomatedTestFilter>& OutFilters)
+{
 	// get our settings CDO where things are stored
 	UAutomationControllerSettings* Settings = UAutomationControllerSettings::StaticClass()->GetDefaultObject<UAutomationControllerSettings>();
 
@@ -199,14 +570,12 @@ void UAGN_RunTests::GenerateTestNames(TSharedPtr<AutomationFilterCollection> InF
 	// 1) If argument is a filter (StartsWith:system) then make sure we only filter-in tests that start with that filter
 	// 2) If argument is a group then expand that group into multiple filters based on ini entries
 	// 3) Otherwise just substring match (default behavior in 4.22 and earlier).
-	FAutomationGroupFilter* FilterAny = new FAutomationGroupFilter();
-	TArray<FAutomatedTestFilter> FiltersList;
-	for (int32 ArgumentIndex = 0; ArgumentIndex < Tests.Num(); ++ArgumentIndex)
+	for (int32 ArgumentIndex = 0; ArgumentIndex < RequestedTests.Num(); ++ArgumentIndex)
 	{
 		const FString GroupPrefix = TEXT("Group:");
 		const FString FilterPrefix = TEXT("StartsWith:");
 
-		FString ArgumentName = Tests[ArgumentIndex].TrimStartAndEnd();
+		FString ArgumentName = RequestedTests[ArgumentIndex].TrimStartAndEnd();
 
 		// if the argument is a filter (e.g. Filter:System) then create a filter that matches from the start
 		if (ArgumentName.StartsWith(FilterPrefix))
@@ -218,7 +587,7 @@ void UAGN_RunTests::GenerateTestNames(TSharedPtr<AutomationFilterCollection> InF
 				FilterName += TEXT(".");
 			}
 
-			FiltersList.Add(FAutomatedTestFilter(FilterName, true, false));
+			OutFilters.Add(FAutomatedTestFilter(FilterName, true, false));
 		}
 		else if (ArgumentName.StartsWith(GroupPrefix))
 		{
@@ -236,7 +605,7 @@ void UAGN_RunTests::GenerateTestNames(TSharedPtr<AutomationFilterCollection> InF
 					// if found add all this groups filters to our current list
 					if (GroupEntry->Filters.Num() > 0)
 					{
-						FiltersList.Append(GroupEntry->Filters);
+						OutFilters.Append(GroupEntry->Filters);
 					}
 					else
 					{
@@ -266,18 +635,582 @@ void UAGN_RunTests::GenerateTestNames(TSharedPtr<AutomationFilterCollection> InF
 				ArgumentName.LeftChopInline(1);
 			}
 
-			FiltersList.Add(FAutomatedTestFilter(ArgumentName, bMatchFromStart, bMatchFromEnd));
+			OutFilters.Add(FAutomatedTestFilter(ArgumentName, bMatchFromStart, bMatchFromEnd));
 		}
 	}
+}
 
-	if (!FiltersList.IsEmpty())
+
+void UAGN_RunTests::WriteFailedTests()
+{
+	FAutomationGraphStringList* FailedTests = WriteOutput<FAutomationGraphStringList>(FailedTestsOutputName);
+	if (!FailedTests || !AutomationController.IsValid())
 	{
-		FilterAny->SetFilters(FiltersList);
-		InFilters->Add(MakeShareable(FilterAny));
+		return;
+	}
 
-		// SetFilter applies all filters from the AutomationFilters array
-		AutomationController->SetFilter(InFilters);
-		// Fill OutFilteredTestNames array with filtered test names
-		AutomationController->GetFilteredTestNames(OutFilteredTestNames);
+	const int32 PassIndex = FMath::Max(AutomationController->GetNumPasses() - 1, 0);
+
+	FAutomationGraphTestHistory TestHistory;
+	TestHistory.Load();
+	
+	for (const TSharedPtr<IAutomationReport>& Report : AutomationController->GetEnabledReports())
+	{
+		if (!Report.IsValid() || Report->GetTotalNumChildren() > 0)
+		{
+			continue;
+		}
+
+		bool bFailed = false;
+		bool bPassed = false;
+		for (int32 ClusterIndex = 0; ClusterIndex < AutomationController->GetNumDeviceClusters(); ++ClusterIndex)
+		{
+			const EAutomationState State = Report->GetState(ClusterIndex, PassIndex);
+			bFailed |= State == EAutomationState::Fail;
+			bPassed |= State == EAutomationState::Success;
+		}
+
+		// Tests that didn't run to completion, e.g. because the run stopped early, don't count either way.
+		if (!bFailed && !bPassed)
+		{
+			continue;
+		}
+		
+		if (bFailed)
+		{
+			FailedTests->Values.AddUnique(Report->GetFullTestPath());
+		}
+
+		float MinDurationSec = 0.0f;
+		float MaxDurationSec = 0.0f;
+		if (!Report->GetDurationRange(MinDurationSec, MaxDurationSec))
+		{
+			MaxDurationSec = -1.0f;
+		}
+		TestHistory.RecordResult(Report->GetFullTestPath(), MaxDurationSec, !bFailed);
+		RecordTestDependencies(TestHistory, Report->GetFullTestPath(), !bFailed);
+	}
+
+	NumFailedTests = FailedTests->Values.Num();
+	TestHistory.Save();
+}
+
+int32 UAGN_RunTests::CountFailedReports() const
+{
+	const int32 PassIndex = FMath::Max(AutomationController->GetNumPasses() - 1, 0);
+
+	int32 NumFailedReports = 0;
+	for (const TSharedPtr<IAutomationReport>& Report : AutomationController->GetEnabledReports())
+	{
+		if (!Report.IsValid() || Report->GetTotalNumChildren() > 0)
+		{
+			continue;
+		}
+
+		for (int32 ClusterIndex = 0; ClusterIndex < AutomationController->GetNumDeviceClusters(); ++ClusterIndex)
+		{
+			if (Report->GetState(ClusterIndex, PassIndex) == EAutomationState::Fail)
+			{
+				NumFailedReports++;
+				break;
+			}
+		}
+	}
+
+	return NumFailedReports;
+}
+
+void UAGN_RunTests::OpenResults()
+{
+	const FString Directory = ResultsDirectory.IsEmpty()
+		? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AutomationGraph"), TEXT("TestResults"), GetName())
+		: ResultsDirectory;
+	
+	ResultsWriter.Open(FPaths::ConvertRelativePathToFull(Directory), Title.ToString());
+}
+
+void UAGN_RunTests::StreamCompletedReports()
+{
+	if (!ResultsWriter.IsOpen())
+	{
+		return;
+	}
+	
+	const int32 PassIndex = FMath::Max(AutomationController->GetNumPasses() - 1, 0);
+	
+	for (const TSharedPtr<IAutomationReport>& Report : AutomationController->GetEnabledReports())
+	{
+		if (!Report.IsValid() || Report->GetTotalNumChildren() > 0 || StreamedTests.Contains(Report->GetFullTestPath()))
+		{
+			continue;
+		}
+
+		// A test is done once every cluster has a final result for it.
+		bool bComplete = true;
+		bool bFailed = false;
+		for (int32 ClusterIndex = 0; ClusterIndex < AutomationController->GetNumDeviceClusters(); ++ClusterIndex)
+		{
+			const EAutomationState State = Report->GetState(ClusterIndex, PassIndex);
+			bComplete &= State == EAutomationState::Success || State == EAutomationState::Fail;
+			bFailed |= State == EAutomationState::Fail;
+		}
+
+		if (!bComplete)
+		{
+			continue;
+		}
+
+		TArray<FString> Errors;
+		for (int32 ClusterIndex = 0; ClusterIndex < AutomationController->GetNumDeviceClusters(); ++ClusterIndex)
+		{
+			for (const FAutomationExecutionEntry& Entry : Report->GetResults(ClusterIndex, PassIndex).GetEntries())
+			{
+				if (Entry.Event.Type == EAutomationEventType::Error)
+				{
+					Errors.Add(Entry.Event.Message);
+				}
+			}
+		}
+
+		float MinDurationSec = 0.0f;
+		float MaxDurationSec = 0.0f;
+		Report->GetDurationRange(MinDurationSec, MaxDurationSec);
+
+		StreamedTests.Add(Report->GetFullTestPath());
+		ResultsWriter.AddResult(Report->GetFullTestPath(), !bFailed, MaxDurationSec, Errors);
+	}
+}
+
+void UAGN_RunTests::FlushBatchReports(const FString& Reason)
+{
+	if (!ResultsWriter.IsOpen())
+	{
+		return;
+	}
+	
+	StreamCompletedReports();
+	
+	const int32 PassIndex = FMath::Max(AutomationController->GetNumPasses() - 1, 0);
+	for (const TSharedPtr<IAutomationReport>& Report : AutomationController->GetEnabledReports())
+	{
+		if (!Report.IsValid() || Report->GetTotalNumChildren() > 0 || StreamedTests.Contains(Report->GetFullTestPath()))
+		{
+			continue;
+		}
+
+		bool bSkippedByController = false;
+		for (int32 ClusterIndex = 0; ClusterIndex < AutomationController->GetNumDeviceClusters(); ++ClusterIndex)
+		{
+			bSkippedByController |= Report->GetState(ClusterIndex, PassIndex) == EAutomationState::Skipped;
+		}
+
+		StreamedTests.Add(Report->GetFullTestPath());
+		ResultsWriter.AddSkipped(Report->GetFullTestPath(), bSkippedByController ? FString(TEXT("Skipped")) : Reason);
+	}
+}
+
+void UAGN_RunTests::WriteSkippedTests(const TArray<FString>& TestNames, const FString& Reason)
+{
+	for (const FString& TestName : TestNames)
+	{
+		if (!StreamedTests.Contains(TestName))
+		{
+			StreamedTests.Add(TestName);
+			ResultsWriter.AddSkipped(TestName, Reason);
+		}
+	}
+}
+
+void UAGN_RunTests::BuildTestBatches(const TArray<FString>& TestNames)
+{
+	TestBatches.Empty();
+	NextTestBatch = 0;
+	if (TestNames.IsEmpty())
+	{
+		return;
+	}
+
+	if (!bRunLikelyFailuresFirst)
+	{
+		TestBatches.Add(TestNames);
+		return;
+	}
+
+	FAutomationGraphTestHistory TestHistory;
+	TestHistory.Load();
+
+	TArray<FString> LikelyFailures;
+	TArray<FString> OtherTests;
+	for (const FString& TestName : TestNames)
+	{
+		if (TestHistory.GetFailureScore(TestName) > 0.0f)
+		{
+			LikelyFailures.Add(TestName);
+		}
+		else
+		{
+			OtherTests.Add(TestName);
+		}
+	}
+
+	// The controller always runs a batch in its own order, so the ordering only carries over between batches.
+	if (!LikelyFailures.IsEmpty())
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphEditor, Log, TEXT("Running %d tests that recently failed or are flaky first"), LikelyFailures.Num());
+		TestBatches.Add(MoveTemp(LikelyFailures));
+	}
+	if (!OtherTests.IsEmpty())
+	{
+		TestBatches.Add(MoveTemp(OtherTests));
+	}
+}
+
+void UAGN_RunTests::StartNextTestBatch()
+{
+	AutomationController->StopTests();
+	AutomationController->SetEnabledTests(TestBatches[NextTestBatch++]);
+	AutomationController->RunTests();
+}
+
+bool UAGN_RunTests::ShouldFailFast(int32 NumFailures) const
+{
+	return FailFastThreshold > 0 && NumFailures >= FailFastThreshold;
+}
+
+void UAGN_RunTests::GenerateLocalTestNames(TArray<FString>& OutTestNames)
+{
+	const FString TestsKey = MakeResolvedTestsKey(FString::Printf(TEXT("Local:%u"), GetTestListVersion()));
+	if (TestsKey == ResolvedTestsKey)
+	{
+		OutTestNames = ResolvedTestNames;
+		return;
+	}
+	
+	OutTestNames.Empty();
+	ResolvedTestsKey = TestsKey;
+	ResolvedTestNames.Empty();
+
+	TArray<FAutomatedTestFilter> FiltersList;
+	GenerateTestFilters(FiltersList);
+	if (FiltersList.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<FAutomationTestInfo> TestInfos;
+	GetAllValidTests(TestInfos);
+
+	for (const FAutomationTestInfo& TestInfo : TestInfos)
+	{
+		const FString TestPath = TestInfo.GetFullTestPath();
+		for (const FAutomatedTestFilter& Filter : FiltersList)
+		{
+			if (PassesFilter(TestPath, Filter))
+			{
+				OutTestNames.Add(TestPath);
+				break;
+			}
+		}
+	}
+
+	ResolvedTestNames = OutTestNames;
+}
+
+void UAGN_RunTests::BuildShards(const TArray<FString>& TestNames)
+{
+	Shards.Empty();
+	if (TestNames.IsEmpty())
+	{
+		return;
+	}
+
+	FAutomationGraphTestHistory TestHistory;
+	TestHistory.Load();
+
+	TArray<TPair<FString, float>> SortedTests;
+	SortedTests.Reserve(TestNames.Num());
+	for (const FString& TestName : TestNames)
+	{
+		SortedTests.Emplace(TestName, TestHistory.GetExpectedDuration(TestName));
+	}
+
+	SortedTests.Sort([](const TPair<FString, float>& A, const TPair<FString, float>& B)
+	{
+		return A.Value > B.Value;
+	});
+
+	Shards.SetNum(FMath::Min(NumLocalWorkers, TestNames.Num()));
+	for (const TPair<FString, float>& Test : SortedTests)
+	{
+		FTestShard* LeastLoaded = &Shards[0];
+		for (FTestShard& Shard : Shards)
+		{
+			if (Shard.ExpectedDurationSec < LeastLoaded->ExpectedDurationSec)
+			{
+				LeastLoaded = &Shard;
+			}
+		}
+
+		LeastLoaded->Tests.Add(Test.Key);
+		LeastLoaded->ExpectedDurationSec += Test.Value;
+	}
+}
+
+bool UAGN_RunTests::LaunchShard(FTestShard& Shard, int32 ShardIndex)
+{
+	Shard.ReportDirectory = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AutomationGraph"), TEXT("TestShards"), GetName(), FString::Printf(TEXT("Shard%d"), ShardIndex)));
+	IFileManager::Get().DeleteDirectory(*Shard.ReportDirectory, false, true);
+	IFileManager::Get().MakeDirectory(*Shard.ReportDirectory, true);
+
+	// One test per line. See QueueWorkerTests().
+	const FString TestListFilePath = FPaths::Combine(Shard.ReportDirectory, TEXT("Tests.txt"));
+	if (!FFileHelper::SaveStringArrayToFile(Shard.Tests, *TestListFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphEditor, Error, TEXT("Failed to write the test list for shard %d to %s"), ShardIndex, *TestListFilePath);
+		return false;
+	}
+
+	const FString ExecutablePath = GetWorkerExecutablePath();
+	const FString Params = FString::Printf(
+		TEXT("\"%s\" -%s\"%s\" -TestExit=\"Automation Test Queue Empty\" -ReportExportPath=\"%s\" -abslog=\"%s\" -unattended -nullrhi -nosplash -nosound -nopause %s"),
+		*FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()),
+		WorkerTestListSwitch,
+		*TestListFilePath,
+		*Shard.ReportDirectory,
+		*FPaths::Combine(Shard.ReportDirectory, TEXT("Worker.log")),
+		*WorkerCommandLine);
+
+	Shard.Process = FPlatformProcess::CreateProc(*ExecutablePath, *Params, false, true, true, nullptr, 0, nullptr, nullptr);
+	if (!Shard.Process.IsValid())
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphEditor, Error, TEXT("Failed to launch test worker %s"), *ExecutablePath);
+		return false;
+	}
+
+	AG_LOG_OBJECT(this, LogAutoGraphEditor, Log, TEXT("Launched test worker %d with %d tests (expected %.1f sec)"), ShardIndex, Shard.Tests.Num(), Shard.ExpectedDurationSec);
+	return true;
+}
+
+bool UAGN_RunTests::IsTestWorker()
+{
+	FString TestListFilePath;
+	return FParse::Value(FCommandLine::Get(), WorkerTestListSwitch, TestListFilePath);
+}
+
+void UAGN_RunTests::QueueWorkerTests()
+{
+	FString TestListFilePath;
+	if (!FParse::Value(FCommandLine::Get(), WorkerTestListSwitch, TestListFilePath))
+	{
+		return;
+	}
+
+	TArray<FString> TestNames;
+	if (!FFileHelper::LoadFileToStringArray(TestNames, *TestListFilePath))
+	{
+		AG_LOG(LogAutoGraphEditor, Error, TEXT("Failed to read the test list at %s"), *TestListFilePath);
+		return;
+	}
+
+	// Anchor each name so that a test doesn't also pull in every test that it happens to be a prefix of.
+	FString TestList;
+	for (const FString& TestName : TestNames)
+	{
+		if (TestName.IsEmpty())
+		{
+			continue;
+		}
+		
+		if (!TestList.IsEmpty())
+		{
+			TestList += TEXT("+");
+		}
+		TestList += FString::Printf(TEXT("^%s$"), *TestName);
+	}
+
+	// Deferred the same way as -ExecCmds, so the tests start once the engine is ticking.
+	GEngine->DeferredCommands.Add(FString::Printf(TEXT("Automation RunTests %s"), *TestList));
+}
+
+void UAGN_RunTests::StopTrackingTestListChanges()
+{
+	if (ModulesChangedHandle.IsValid())
+	{
+		FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+		ModulesChangedHandle.Reset();
+	}
+	if (ReloadCompleteHandle.IsValid())
+	{
+		FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+		ReloadCompleteHandle.Reset();
+	}
+}
+
+void UAGN_RunTests::TerminateShards()
+{
+	for (FTestShard& Shard : Shards)
+	{
+		if (!Shard.Process.IsValid())
+		{
+			continue;
+		}
+
+		if (FPlatformProcess::IsProcRunning(Shard.Process))
+		{
+			FPlatformProcess::TerminateProc(Shard.Process, true);
+		}
+		FPlatformProcess::CloseProc(Shard.Process);
+	}
+
+	Shards.Empty();
+}
+
+void UAGN_RunTests::MergeShardResult(FTestShard& Shard, int32 ShardIndex)
+{
+	Shard.bMerged = true;
+
+	FAutomationGraphStringList* FailedTests = WriteOutput<FAutomationGraphStringList>(FailedTestsOutputName);
+	if (!FailedTests)
+	{
+		return;
+	}
+
+	FAutomationGraphTestHistory TestHistory;
+	TestHistory.Load();
+
+	TSet<FString> ReportedTests;
+	FString ReportString;
+	TSharedPtr<FJsonObject> Report;
+	const FString ReportPath = FPaths::Combine(Shard.ReportDirectory, TEXT("index.json"));
+	if (FFileHelper::LoadFileToString(ReportString, *ReportPath) && FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ReportString), Report) && Report.IsValid())
+	{
+		const TArray<TSharedPtr<FJsonValue>>* TestResults = nullptr;
+		if (Report->TryGetArrayField(TEXT("tests"), TestResults))
+		{
+			for (const TSharedPtr<FJsonValue>& TestResult : *TestResults)
+			{
+				const TSharedPtr<FJsonObject>* TestObject = nullptr;
+				if (!TestResult.IsValid() || !TestResult->TryGetObject(TestObject))
+				{
+					continue;
+				}
+
+				const FString TestPath = (*TestObject)->GetStringField(TEXT("fullTestPath"));
+				const FString State = (*TestObject)->GetStringField(TEXT("state"));
+				ReportedTests.Add(TestPath);
+
+				// InProcess means the worker died partway through the test. NotRun and Skipped tests didn't prove
+				// anything either way, so they are only reported.
+				const bool bFailed = State == TEXT("Fail") || State == TEXT("InProcess");
+				if (!bFailed && State != TEXT("Success"))
+				{
+					ResultsWriter.AddSkipped(TestPath, State == TEXT("Skipped") ? FString(TEXT("Skipped")) : FString(TEXT("Did not run")));
+					continue;
+				}
+				
+				if (bFailed)
+				{
+					FailedTests->Values.AddUnique(TestPath);
+				}
+
+				double DurationSec = -1.0;
+				(*TestObject)->TryGetNumberField(TEXT("duration"), DurationSec);
+
+				TArray<FString> Errors;
+				const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+				if ((*TestObject)->TryGetArrayField(TEXT("entries"), Entries))
+				{
+					for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+					{
+						const TSharedPtr<FJsonObject>* EntryObject = nullptr;
+						const TSharedPtr<FJsonObject>* EventObject = nullptr;
+						if (Entry.IsValid() && Entry->TryGetObject(EntryObject) && (*EntryObject)->TryGetObjectField(TEXT("event"), EventObject)
+							&& (*EventObject)->GetStringField(TEXT("type")) == TEXT("Error"))
+						{
+							Errors.Add((*EventObject)->GetStringField(TEXT("message")));
+						}
+					}
+				}
+				ResultsWriter.AddResult(TestPath, !bFailed, static_cast<float>(DurationSec), Errors);
+				TestHistory.RecordResult(TestPath, static_cast<float>(DurationSec), !bFailed);
+				RecordTestDependencies(TestHistory, TestPath, !bFailed);
+			}
+		}
+	}
+	else
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphEditor, Error, TEXT("Test worker %d did not write a report, see %s"), ShardIndex, *FPaths::Combine(Shard.ReportDirectory, TEXT("Worker.log")));
+	}
+
+	// Anything the worker never reported on (e.g. because it crashed) counts as a failure.
+	for (const FString& TestName : Shard.Tests)
+	{
+		if (!ReportedTests.Contains(TestName))
+		{
+			FailedTests->Values.AddUnique(TestName);
+			ResultsWriter.AddResult(TestName, false, -1.0f, {FString::Printf(TEXT("Test worker %d exited without reporting this test"), ShardIndex)});
+			TestHistory.RecordResult(TestName, -1.0f, false);
+			RecordTestDependencies(TestHistory, TestName, false);
+		}
 	}
+
+	NumFailedTests = FailedTests->Values.Num();
+	TestHistory.Save();
 }
+
+void UAGN_RunTests::SelectImpactedTests(TArray<FString>& InOutTestNames)
+{
+	TestDependencyHashes.Empty();
+	if (!bOnlyImpactedTests || InOutTestNames.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<FAutomationTestInfo> TestInfos;
+	GetAllValidTests(TestInfos);
+	
+	TMap<FString, const FAutomationTestInfo*> TestInfosByPath;
+	for (const FAutomationTestInfo& TestInfo : TestInfos)
+	{
+		TestInfosByPath.Add(TestInfo.GetFullTestPath(), &TestInfo);
+	}
+
+	FAutomationGraphTestHistory TestHistory;
+	TestHistory.Load();
+	FAutomationGraphTestImpact TestImpact;
+	
+	const int32 NumMatchedTests = InOutTestNames.Num();
+	TArray<FString> UnchangedTests;
+	InOutTestNames.RemoveAll([&](const FString& TestName)
+	{
+		// Tests that only exist on a remote worker can't be checked here, so they always run.
+		const FAutomationTestInfo* const* TestInfo = TestInfosByPath.Find(TestName);
+		if (!TestInfo)
+		{
+			return false;
+		}
+
+		const FString DependencyHash = TestImpact.GetDependencyHash(**TestInfo);
+		if (TestHistory.PassedWithDependencies(TestName, DependencyHash))
+		{
+			UnchangedTests.Add(TestName);
+			return true;
+		}
+
+		TestDependencyHashes.Add(TestName, DependencyHash);
+		return false;
+	});
+
+	// The reports list every selected test, so that a report doesn't look like it covers fewer tests than were asked for.
+	WriteSkippedTests(UnchangedTests, TEXT("unchanged since last pass"));
+
+	AG_LOG_OBJECT(this, LogAutoGraphEditor, Log, TEXT("Running %d of %d tests, the rest passed last time with the same dependencies"), InOutTestNames.Num(), NumMatchedTests);
+}
+
+void UAGN_RunTests::RecordTestDependencies(FAutomationGraphTestHistory& TestHistory, const FString& TestPath, bool bPassed) const
+{
+	if (const FString* DependencyHash = TestDependencyHashes.Find(TestPath))
+	{
+		TestHistory.RecordDependencies(TestPath, *DependencyHash, bPassed);
+	}
+}
\ No newline at end of file
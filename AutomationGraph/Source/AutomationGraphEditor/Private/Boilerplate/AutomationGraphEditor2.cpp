@@ -40,6 +40,8 @@ void FAutomationGraphEditorCommands::RegisterCommands()
 {
 	UI_COMMAND(ExecuteGraph, "Run", "Run", EUserInterfaceActionType::Button, FInputChord());
 	UI_COMMAND(CancelExecution, "Stop", "Stop", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(ExecuteSelectedNodes, "Run Selected", "Run the selected nodes and everything downstream of them", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(ToggleWatch, "Watch", "Re-run the affected part of the graph whenever a node is edited", EUserInterfaceActionType::ToggleButton, FInputChord());
 }
 
 void FAutomationGraphEditor::BuildCustomCommands()
@@ -54,6 +56,17 @@ void FAutomationGraphEditor::BuildCustomCommands()
 		FExecuteAction::CreateSP(this, &FAutomationGraphEditor::CancelExecution),
 		FCanExecuteAction::CreateSP(this, &FAutomationGraphEditor::CanCancelExecution)
 	);
+	ToolkitCommands->MapAction(
+		FAutomationGraphEditorCommands::Get().ExecuteSelectedNodes,
+		FExecuteAction::CreateSP(this, &FAutomationGraphEditor::ExecuteSelectedNodes),
+		FCanExecuteAction::CreateSP(this, &FAutomationGraphEditor::CanExecuteSelectedNodes)
+	);
+	ToolkitCommands->MapAction(
+		FAutomationGraphEditorCommands::Get().ToggleWatch,
+		FExecuteAction::CreateSP(this, &FAutomationGraphEditor::ToggleWatch),
+		FCanExecuteAction(),
+		FIsActionChecked::CreateSP(this, &FAutomationGraphEditor::IsWatchEnabled)
+	);
 }
 
 void FAutomationGraphEditor::BuildGraphEditorCommands()
@@ -426,4 +426,111 @@ void UEdGraph_AutomationGraph::RebuildAutomationGraph()
 	}
 }
 
+void UEdGraph_AutomationGraph::RebuildEditorGraph()
+{
+	UAutomationGraph* AutomationGraph = GetAutomationGraph();
+
+	// Lay the nodes out in columns by their depth (longest path from a root), so the generated graph reads left to
+	// right in execution order.
+	TArray<UAutomationGraphNode*> SortedNodes;
+	TMap<UAutomationGraphNode*, int32> NodeDepth;
+	TMap<UAutomationGraphNode*, int32> RemainingParents;
+
+	for (UAutomationGraphNode* RootNode : AutomationGraph->RootNodes)
+	{
+		if (RootNode && !NodeDepth.Contains(RootNode))
+		{
+			NodeDepth.Add(RootNode, 0);
+			SortedNodes.Add(RootNode);
+		}
+	}
+	
+	for (int32 SortIndex = 0; SortIndex < SortedNodes.Num(); ++SortIndex)
+	{
+		UAutomationGraphNode* AutomationNode = SortedNodes[SortIndex];
+		int32 ChildDepth = NodeDepth[AutomationNode] + 1;
+		
+		for (UAutomationGraphNode* ChildNode : AutomationNode->ChildNodes)
+		{
+			int32& ChildRemainingParents = RemainingParents.FindOrAdd(ChildNode, ChildNode->ParentNodes.Num());
+			int32& CurrentChildDepth = NodeDepth.FindOrAdd(ChildNode, 0);
+			CurrentChildDepth = FMath::Max(CurrentChildDepth, ChildDepth);
+			
+			if (--ChildRemainingParents == 0)
+			{
+				SortedNodes.Add(ChildNode);
+			}
+		}
+	}
+
+	const int32 ColumnWidth = 400;
+	const int32 RowHeight = 150;
+	TMap<int32, int32> RowsPerColumn;
+	TMap<UAutomationGraphNode*, UEdNode_AutomationGraphNode*> EdNodes;
+	EdNodes.Reserve(SortedNodes.Num());
+
+	for (UAutomationGraphNode* AutomationNode : SortedNodes)
+	{
+		FGraphNodeCreator<UEdNode_AutomationGraphNode> NodeCreator(*this);
+		UEdNode_AutomationGraphNode* EdNode = NodeCreator.CreateNode(false);
+		EdNode->AutomationNode = AutomationNode;
+		NodeCreator.Finalize();
+
+		int32 Column = NodeDepth[AutomationNode];
+		int32& Row = RowsPerColumn.FindOrAdd(Column, 0);
+		EdNode->NodePosX = Column * ColumnWidth;
+		EdNode->NodePosY = Row * RowHeight;
+		Row++;
+
+		if (const FIntPoint* StoredPosition = AutomationGraph->EditorNodePositions.Find(AutomationNode))
+		{
+			EdNode->NodePosX = StoredPosition->X;
+			EdNode->NodePosY = StoredPosition->Y;
+		}
+
+		EdNodes.Add(AutomationNode, EdNode);
+	}
+
+	for (UAutomationGraphNode* AutomationNode : SortedNodes)
+	{
+		UEdNode_AutomationGraphNode* StartNode = EdNodes[AutomationNode];
+		
+		for (UAutomationGraphNode* ChildNode : AutomationNode->ChildNodes)
+		{
+			UEdNode_AutomationGraphNode** EndNode = EdNodes.Find(ChildNode);
+			if (!EndNode)
+			{
+				continue;
+			}
+			
+			FGraphNodeCreator<UEdNode_AutomationGraphEdge> EdgeCreator(*this);
+			UEdNode_AutomationGraphEdge* EdgeNode = EdgeCreator.CreateNode(false);
+			EdgeCreator.Finalize();
+			EdgeNode->CreateConnections(StartNode, *EndNode);
+			EdgeNode->NodePosX = (StartNode->NodePosX + (*EndNode)->NodePosX) / 2;
+			EdgeNode->NodePosY = (StartNode->NodePosY + (*EndNode)->NodePosY) / 2;
+		}
+	}
+
+	if (SortedNodes.Num() != NodeDepth.Num())
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphEditor, Warning, TEXT("Some nodes could not be placed while rebuilding the editor graph. The graph may contain a cycle."));
+	}
+}
+
+void UEdGraph_AutomationGraph::StoreNodePositions()
+{
+	UAutomationGraph* AutomationGraph = GetAutomationGraph();
+	AutomationGraph->EditorNodePositions.Reset();
+	
+	for (UEdGraphNode* EdGraphNode : Nodes)
+	{
+		auto* AutomationGraphNode = Cast<UEdNode_AutomationGraphNode>(EdGraphNode);
+		if (AutomationGraphNode && AutomationGraphNode->AutomationNode)
+		{
+			AutomationGraph->EditorNodePositions.Add(AutomationGraphNode->AutomationNode, FIntPoint(AutomationGraphNode->NodePosX, AutomationGraphNode->NodePosY));
+		}
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
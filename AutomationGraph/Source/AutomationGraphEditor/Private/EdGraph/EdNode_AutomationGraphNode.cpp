@@ -34,6 +34,7 @@
 #include "AutomationGraphEditorConstants.h"
 #include "AutomationGraphEditorLoggingDefs.h"
 #include "Boilerplate/AutomationGraphDragConnection.h"
+#include "Foundation/AutomationGraph.h"
 #include "GraphEditorSettings.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "SCommentBubble.h"
@@ -353,6 +354,18 @@ void UEdNode_AutomationGraphNode::PrepareForCopying()
 	AutomationNode->Rename(nullptr, this, REN_DontCreateRedirectors | REN_DoNotDirty);
 }
 
+void UEdNode_AutomationGraphNode::PostCopyNode()
+{
+	Super::PostCopyNode();
+	ResetAutomationNodeOwner();
+}
+
+void UEdNode_AutomationGraphNode::PostPasteNode()
+{
+	Super::PostPasteNode();
+	ResetAutomationNodeOwner();
+}
+
 void UEdNode_AutomationGraphNode::AutowireNewNode(UEdGraphPin* FromPin)
 {
 	Super::AutowireNewNode(FromPin);
@@ -394,4 +407,13 @@ const FSlateBrush* UEdNode_AutomationGraphNode::GetNodeIcon()
 	// return FAppStyle::GetBrush(TEXT("BTEditor.Graph.BTNode.Icon"));
 }
 
+void UEdNode_AutomationGraphNode::ResetAutomationNodeOwner()
+{
+	UAutomationGraph* AutomationGraph = GetTypedOuter<UAutomationGraph>();
+	if (AutomationNode && AutomationGraph && AutomationNode->GetOuter() != AutomationGraph)
+	{
+		AutomationNode->Rename(nullptr, AutomationGraph, REN_DontCreateRedirectors | REN_DoNotDirty);
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
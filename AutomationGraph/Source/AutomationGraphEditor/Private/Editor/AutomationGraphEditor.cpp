@@ -80,9 +80,18 @@ void FAutomationGraphEditor::Initialize(
 		);
 		TargetGraph->EditorGraph->bAllowDeletion = false;
 
+		// The editor graph is regenerated every time the asset is opened, so it is never saved with the asset.
+		TargetGraph->EditorGraph->SetFlags(RF_Transient);
+
 		// Give the schema a chance to fill out any required nodes.
 		const UEdGraphSchema* Schema = TargetGraph->EditorGraph->GetSchema();
 		Schema->CreateDefaultNodesForGraph(*TargetGraph->EditorGraph);
+
+		// Graphs built in code only have runtime nodes. Generate the visual graph for them now.
+		if (!TargetGraph->RootNodes.IsEmpty())
+		{
+			CastChecked<UEdGraph_AutomationGraph>(TargetGraph->EditorGraph)->RebuildEditorGraph();
+		}
 	}
 
 	FGenericCommands::Register();
@@ -139,6 +148,11 @@ void FAutomationGraphEditor::OnClose()
 	if (TargetGraph)
 	{
 		TargetGraph->UninitializeNodes();
+
+		if (auto* AutomationGraphSubsystem = GEditor->GetEditorSubsystem<UAutomationGraphSubsystem>())
+		{
+			AutomationGraphSubsystem->SetWatchEnabled(TargetGraph, false);
+		}
 	}
 	
 	FAssetEditorToolkit::OnClose();
@@ -313,7 +327,15 @@ void FAutomationGraphEditor::CopySelectedNodes()
 	FEdGraphUtilities::ExportNodesToText(SelectedNodes, ExportedText);
 	FPlatformApplicationMisc::ClipboardCopy(*ExportedText);
 
-	// TODO(): Determine if the node's owner needs to change. See FSoundCueEditor::CopySelectedNodes() -> PostCopyNode
+	// PrepareForCopying() moved each automation node into its editor node so it would be exported with it. Move them
+	// back under the graph.
+	for (UObject* SelectedNode : SelectedNodes)
+	{
+		if (auto* EdNode = Cast<UEdNode_AutomationGraphNode>(SelectedNode))
+		{
+			EdNode->PostCopyNode();
+		}
+	}
 }
 
 bool FAutomationGraphEditor::CanPasteNodes()
@@ -483,6 +505,20 @@ void FAutomationGraphEditor::ExtendToolbar()
 					LOCTEXT("Stupbutton_Tooltip", "Cancels this graph, if it is running"),
 					FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Toolbar.Stop")
 				);
+				ToolBarBuilder.AddToolBarButton(
+					FAutomationGraphEditorCommands::Get().ExecuteSelectedNodes,
+					NAME_None,
+					LOCTEXT("RunSelectedButton_Label", "Run Selected"),
+					LOCTEXT("RunSelectedButton_Tooltip", "Runs the selected nodes and everything downstream of them. Every other node keeps its result from the last run."),
+					FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Play")
+				);
+				ToolBarBuilder.AddToolBarButton(
+					FAutomationGraphEditorCommands::Get().ToggleWatch,
+					NAME_None,
+					LOCTEXT("WatchButton_Label", "Watch"),
+					LOCTEXT("WatchButton_Tooltip", "When enabled, editing a node re-runs that node and everything downstream of it"),
+					FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Visible")
+				);
 			}
 			ToolBarBuilder.EndSection();
 		}
@@ -520,7 +556,7 @@ void FAutomationGraphEditor::ExecuteGraph()
 		return;
 	}
 
-	AutomationGraphSubsystem->EnqueueAutomationGraph(TargetGraph, EAutomationGraphNodeTrigger::OnPlay);
+	AutomationGraphSubsystem->EnqueueAutomationGraph(TargetGraph, EAutomationGraphNodeTrigger::OnPlay, EAutomationGraphTaskPriority::Interactive);
 }
 
 bool FAutomationGraphEditor::CanCancelExecution() const
@@ -542,4 +578,51 @@ void FAutomationGraphEditor::CancelExecution()
 	}
 }
 
+bool FAutomationGraphEditor::CanExecuteSelectedNodes() const
+{
+	return GetSelectedNodes().Num() > 0;
+}
+
+void FAutomationGraphEditor::ExecuteSelectedNodes()
+{
+	if (!TargetGraph)
+	{
+		AG_LOG(LogAutoGraphEditor, Error, TEXT("TargetGraph is invalid"));
+		return;
+	}
+	
+	auto* AutomationGraphSubsystem = GEditor->GetEditorSubsystem<UAutomationGraphSubsystem>();
+	if (!AutomationGraphSubsystem)
+	{
+		AG_LOG(LogAutoGraphEditor, Error, TEXT("AutomationGraphSubsystem is invalid"));
+		return;
+	}
+
+	TArray<UAutomationGraphNode*> DirtyNodes;
+	for (UObject* SelectedObject : GetSelectedNodes())
+	{
+		auto* EdNode = Cast<UEdNode_AutomationGraphNode>(SelectedObject);
+		if (EdNode && EdNode->AutomationNode)
+		{
+			DirtyNodes.Add(EdNode->AutomationNode);
+		}
+	}
+
+	AutomationGraphSubsystem->EnqueueDirtySubgraph(TargetGraph, DirtyNodes);
+}
+
+bool FAutomationGraphEditor::IsWatchEnabled() const
+{
+	auto* AutomationGraphSubsystem = GEditor->GetEditorSubsystem<UAutomationGraphSubsystem>();
+	return AutomationGraphSubsystem && AutomationGraphSubsystem->IsWatchEnabled(TargetGraph);
+}
+
+void FAutomationGraphEditor::ToggleWatch()
+{
+	if (auto* AutomationGraphSubsystem = GEditor->GetEditorSubsystem<UAutomationGraphSubsystem>())
+	{
+		AutomationGraphSubsystem->SetWatchEnabled(TargetGraph, !AutomationGraphSubsystem->IsWatchEnabled(TargetGraph));
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
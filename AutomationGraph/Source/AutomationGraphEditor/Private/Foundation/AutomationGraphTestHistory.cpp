@@ -0,0 +1,216 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Foundation/AutomationGraphTestHistory.h"
+
+#include "AutomationGraphEditorLoggingDefs.h"
+#include "JsonObjectConverter.h"
+#include "Macros/AutomationGraphLoggingMacros.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// Weight of the latest run in the moving average.
+	constexpr float DurationSmoothing = 0.3f;
+	constexpr float DefaultDurationSec = 1.0f;
+}
+
+FString FAutomationGraphTestHistory::GetHistoryFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AutomationGraph"), TEXT("TestHistory.json"));
+}
+
+void FAutomationGraphTestHistory::Load()
+{
+	PendingResults.Empty();
+	LoadData(Data);
+	UpdateAverageDuration();
+}
+
+bool FAutomationGraphTestHistory::Save()
+{
+	if (PendingResults.IsEmpty())
+	{
+		return true;
+	}
+
+	// Another node may have saved since this history was loaded, so start from what is on disk now.
+	FAutomationGraphTestHistoryData LatestData;
+	LoadData(LatestData);
+	for (const FPendingResult& Result : PendingResults)
+	{
+		ApplyResult(LatestData, Result);
+	}
+
+	FString HistoryString;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(LatestData, HistoryString))
+	{
+		AG_LOG(LogAutoGraphEditor, Error, TEXT("Failed to serialize test history"));
+		return false;
+	}
+
+	// Write to a temporary file first so that a concurrent reader never sees a half-written history.
+	const FString FilePath = GetHistoryFilePath();
+	const FString TempFilePath = FilePath + FString::Printf(TEXT(".%u.tmp"), FPlatformProcess::GetCurrentProcessId());
+	if (!FFileHelper::SaveStringToFile(HistoryString, *TempFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		|| !IFileManager::Get().Move(*FilePath, *TempFilePath, true, true))
+	{
+		AG_LOG(LogAutoGraphEditor, Error, TEXT("Failed to write test history to %s"), *FilePath);
+		IFileManager::Get().Delete(*TempFilePath, false, false, true);
+		return false;
+	}
+
+	Data = MoveTemp(LatestData);
+	PendingResults.Empty();
+	UpdateAverageDuration();
+	return true;
+}
+
+void FAutomationGraphTestHistory::RecordResult(const FString& TestPath, float DurationSec, bool bPassed)
+{
+	FPendingResult& Result = PendingResults.AddDefaulted_GetRef();
+	Result.TestPath = TestPath;
+	Result.DurationSec = DurationSec;
+	Result.bPassed = bPassed;
+	ApplyResult(Data, Result);
+}
+
+void FAutomationGraphTestHistory::RecordDependencies(const FString& TestPath, const FString& DependencyHash, bool bPassed)
+{
+	FPendingResult& Result = PendingResults.AddDefaulted_GetRef();
+	Result.TestPath = TestPath;
+	Result.bPassed = bPassed;
+	Result.bDependenciesOnly = true;
+	Result.DependencyHash = DependencyHash;
+	ApplyResult(Data, Result);
+}
+
+bool FAutomationGraphTestHistory::LoadData(FAutomationGraphTestHistoryData& OutData)
+{
+	OutData = FAutomationGraphTestHistoryData();
+
+	FString FilePath = GetHistoryFilePath();
+	FString HistoryString;
+	if (!FFileHelper::LoadFileToString(HistoryString, *FilePath))
+	{
+		return false;
+	}
+	
+	if (!FJsonObjectConverter::JsonObjectStringToUStruct(HistoryString, &OutData))
+	{
+		AG_LOG(LogAutoGraphEditor, Warning, TEXT("Ignoring malformed test history at %s"), *FilePath);
+		OutData = FAutomationGraphTestHistoryData();
+		return false;
+	}
+
+	return true;
+}
+
+void FAutomationGraphTestHistory::ApplyResult(FAutomationGraphTestHistoryData& InOutData, const FPendingResult& Result)
+{
+	FAutomationGraphTestRecord& Record = InOutData.Tests.FindOrAdd(Result.TestPath);
+	if (Result.bDependenciesOnly)
+	{
+		Record.PassedDependencyHash = Result.bPassed ? Result.DependencyHash : FString();
+		return;
+	}
+	
+	if (Result.DurationSec >= 0.0f)
+	{
+		if (Record.NumTimedRuns == 0)
+		{
+			Record.AverageDurationSec = Result.DurationSec;
+		}
+		else
+		{
+			Record.AverageDurationSec = FMath::Lerp(Record.AverageDurationSec, Result.DurationSec, DurationSmoothing);
+		}
+		Record.NumTimedRuns++;
+	}
+
+	if (Record.NumRuns > 0 && Record.bFailedLastRun == Result.bPassed)
+	{
+		Record.NumResultChanges++;
+	}
+	
+	Record.NumRuns++;
+	Record.NumFailures += Result.bPassed ? 0 : 1;
+	Record.bFailedLastRun = !Result.bPassed;
+
+	// A failure from a run that didn't record dependencies must still stop the test from being skipped as unchanged.
+	if (!Result.bPassed)
+	{
+		Record.PassedDependencyHash.Reset();
+	}
+}
+
+bool FAutomationGraphTestHistory::PassedWithDependencies(const FString& TestPath, const FString& DependencyHash) const
+{
+	const FAutomationGraphTestRecord* Record = Data.Tests.Find(TestPath);
+	return Record && !DependencyHash.IsEmpty() && Record->PassedDependencyHash == DependencyHash;
+}
+
+float FAutomationGraphTestHistory::GetFailureScore(const FString& TestPath) const
+{
+	const FAutomationGraphTestRecord* Record = Data.Tests.Find(TestPath);
+	if (!Record || Record->NumRuns == 0)
+	{
+		return 0.0f;
+	}
+
+	const float Flakiness = static_cast<float>(Record->NumResultChanges) / Record->NumRuns;
+	return (Record->bFailedLastRun ? 1.0f : 0.0f) + Flakiness;
+}
+
+float FAutomationGraphTestHistory::GetExpectedDuration(const FString& TestPath) const
+{
+	const FAutomationGraphTestRecord* Record = Data.Tests.Find(TestPath);
+	return Record && Record->NumTimedRuns > 0 ? Record->AverageDurationSec : AverageDurationSec;
+}
+
+void FAutomationGraphTestHistory::UpdateAverageDuration()
+{
+	float TotalDurationSec = 0.0f;
+	int32 NumTimedTests = 0;
+	for (const TPair<FString, FAutomationGraphTestRecord>& Test : Data.Tests)
+	{
+		if (Test.Value.NumTimedRuns > 0)
+		{
+			TotalDurationSec += Test.Value.AverageDurationSec;
+			NumTimedTests++;
+		}
+	}
+	
+	AverageDurationSec = NumTimedTests > 0 ? TotalDurationSec / NumTimedTests : DefaultDurationSec;
+}
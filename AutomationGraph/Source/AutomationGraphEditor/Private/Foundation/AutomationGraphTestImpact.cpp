@@ -0,0 +1,316 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Foundation/AutomationGraphTestImpact.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Foundation/AutomationGraphResultCache.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+FString FAutomationGraphTestImpact::GetDependencyHash(const FAutomationTestInfo& TestInfo)
+{
+	FAutomationGraphCacheInputs Inputs;
+	bool bHasDependencies = false;
+
+	const FString RulesFile = FindModuleRulesFile(TestInfo.GetSourceFile());
+	if (!RulesFile.IsEmpty())
+	{
+		for (const FString& ModuleRulesFile : GetModuleClosure(RulesFile))
+		{
+			Inputs.AddString(GetModuleHash(FPaths::GetPath(ModuleRulesFile)));
+		}
+		Inputs.AddString(FEngineVersion::Current().ToString());
+		bHasDependencies = true;
+	}
+
+	const FName PackageName = GetTestPackageName(TestInfo);
+	if (!PackageName.IsNone())
+	{
+		AddPackageDependencies(PackageName, Inputs);
+		bHasDependencies = true;
+	}
+
+	if (!bHasDependencies || !Inputs.IsValid())
+	{
+		return FString();
+	}
+	
+	return Inputs.Finalize();
+}
+
+FString FAutomationGraphTestImpact::FindModuleRulesFile(const FString& SourceFile)
+{
+	if (SourceFile.IsEmpty())
+	{
+		return FString();
+	}
+
+	const FString SourceDirectory = FPaths::GetPath(FPaths::ConvertRelativePathToFull(SourceFile));
+	if (const FString* RulesFile = SourceDirectoryToModule.Find(SourceDirectory))
+	{
+		return *RulesFile;
+	}
+
+	FString RulesFile;
+	for (FString Directory = SourceDirectory; !Directory.IsEmpty(); Directory = FPaths::GetPath(Directory))
+	{
+		TArray<FString> BuildFiles;
+		IFileManager::Get().FindFiles(BuildFiles, *FPaths::Combine(Directory, TEXT("*.Build.cs")), true, false);
+		if (!BuildFiles.IsEmpty())
+		{
+			RulesFile = FPaths::Combine(Directory, BuildFiles[0]);
+			break;
+		}
+
+		if (FPaths::IsDrive(Directory) || FPaths::GetPath(Directory) == Directory)
+		{
+			break;
+		}
+	}
+
+	SourceDirectoryToModule.Add(SourceDirectory, RulesFile);
+	return RulesFile;
+}
+
+const FString& FAutomationGraphTestImpact::GetModuleHash(const FString& ModuleDirectory)
+{
+	if (const FString* ModuleHash = ModuleHashes.Find(ModuleDirectory))
+	{
+		return *ModuleHash;
+	}
+
+	// Timestamps rather than contents, so that large modules stay cheap to fingerprint. Touching a file without
+	// changing it just means its tests run again.
+	TArray<TPair<FString, FDateTime>> Files;
+	IFileManager::Get().IterateDirectoryStatRecursively(*ModuleDirectory, [&Files](const TCHAR* Path, const FFileStatData& StatData)
+	{
+		if (!StatData.bIsDirectory)
+		{
+			Files.Emplace(Path, StatData.ModificationTime);
+		}
+		return true;
+	});
+
+	// Directory iteration order isn't guaranteed to be stable.
+	Files.Sort([](const TPair<FString, FDateTime>& A, const TPair<FString, FDateTime>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	FAutomationGraphCacheInputs Inputs;
+	Inputs.AddString(ModuleDirectory);
+	for (const TPair<FString, FDateTime>& File : Files)
+	{
+		Inputs.AddString(File.Key);
+		Inputs.AddString(LexToString(File.Value.GetTicks()));
+	}
+	
+	return ModuleHashes.Add(ModuleDirectory, Inputs.Finalize());
+}
+
+const TArray<FString>& FAutomationGraphTestImpact::GetModuleClosure(const FString& RulesFile)
+{
+	if (const TArray<FString>* Closure = ModuleClosures.Find(RulesFile))
+	{
+		return *Closure;
+	}
+
+	DiscoverProjectModules();
+	
+	TArray<FString> Closure;
+	TSet<FString> Visited;
+	TArray<FString> PendingRulesFiles = {RulesFile};
+	while (!PendingRulesFiles.IsEmpty())
+	{
+		const FString ModuleRulesFile = PendingRulesFiles.Pop();
+		if (Visited.Contains(ModuleRulesFile))
+		{
+			continue;
+		}
+
+		Visited.Add(ModuleRulesFile);
+		Closure.Add(ModuleRulesFile);
+		for (const FString& ModuleName : GetReferencedModules(ModuleRulesFile))
+		{
+			PendingRulesFiles.Add(ProjectModuleRulesFiles.FindChecked(ModuleName));
+		}
+	}
+
+	Closure.Sort();
+	return ModuleClosures.Add(RulesFile, MoveTemp(Closure));
+}
+
+TArray<FString> FAutomationGraphTestImpact::GetReferencedModules(const FString& RulesFile)
+{
+	TArray<FString> ModuleNames;
+	
+	FString RulesText;
+	if (!FFileHelper::LoadFileToString(RulesText, *RulesFile))
+	{
+		return ModuleNames;
+	}
+
+	int32 LiteralStart = INDEX_NONE;
+	for (int32 CharIndex = 0; CharIndex < RulesText.Len(); ++CharIndex)
+	{
+		if (RulesText[CharIndex] != TEXT('"'))
+		{
+			continue;
+		}
+
+		if (LiteralStart == INDEX_NONE)
+		{
+			LiteralStart = CharIndex + 1;
+			continue;
+		}
+
+		const FString Literal = RulesText.Mid(LiteralStart, CharIndex - LiteralStart);
+		if (ProjectModuleRulesFiles.Contains(Literal))
+		{
+			ModuleNames.AddUnique(Literal);
+		}
+		LiteralStart = INDEX_NONE;
+	}
+
+	return ModuleNames;
+}
+
+void FAutomationGraphTestImpact::DiscoverProjectModules()
+{
+	if (bDiscoveredProjectModules)
+	{
+		return;
+	}
+
+	bDiscoveredProjectModules = true;
+	for (const FString& RootDirectory : {FPaths::Combine(FPaths::ProjectDir(), TEXT("Source")), FPaths::ProjectPluginsDir()})
+	{
+		TArray<FString> RulesFiles;
+		IFileManager::Get().FindFilesRecursive(RulesFiles, *FPaths::ConvertRelativePathToFull(RootDirectory), TEXT("*.Build.cs"), true, false);
+		for (const FString& RulesFile : RulesFiles)
+		{
+			// Foo.Build.cs -> Foo
+			ProjectModuleRulesFiles.Add(FPaths::GetBaseFilename(FPaths::GetBaseFilename(RulesFile)), RulesFile);
+		}
+	}
+}
+
+void FAutomationGraphTestImpact::AddPackageDependencies(FName PackageName, FAutomationGraphCacheInputs& Inputs)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	
+	TArray<FName>* Dependencies = PackageDependencies.Find(PackageName);
+	if (!Dependencies)
+	{
+		TArray<FName> AllDependencies;
+		TSet<FName> Visited;
+		TArray<FName> PendingPackages = {PackageName};
+		while (!PendingPackages.IsEmpty())
+		{
+			const FName Package = PendingPackages.Pop();
+			if (Visited.Contains(Package))
+			{
+				continue;
+			}
+			
+			Visited.Add(Package);
+			AllDependencies.Add(Package);
+
+			TArray<FName> PackageReferences;
+			AssetRegistry.GetDependencies(Package, PackageReferences, UE::AssetRegistry::EDependencyCategory::Package);
+			for (const FName& Reference : PackageReferences)
+			{
+				// Script packages only change along with the code, which is covered by the module hash.
+				if (!FPackageName::IsScriptPackage(Reference.ToString()))
+				{
+					PendingPackages.Add(Reference);
+				}
+			}
+		}
+
+		AllDependencies.Sort(FNameLexicalLess());
+		Dependencies = &PackageDependencies.Add(PackageName, MoveTemp(AllDependencies));
+	}
+
+	for (const FName& Dependency : *Dependencies)
+	{
+		const FString DependencyName = Dependency.ToString();
+		Inputs.AddString(DependencyName);
+
+		if (UPackage* LoadedPackage = FindPackage(nullptr, *DependencyName))
+		{
+			if (LoadedPackage->IsDirty())
+			{
+				Inputs.Invalidate(FString::Printf(TEXT("%s has unsaved changes"), *DependencyName));
+				return;
+			}
+		}
+
+		TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Dependency);
+		Inputs.AddString(PackageData.IsSet() ? LexToString(PackageData->GetPackageSavedHash()) : TEXT("missing"));
+	}
+}
+
+FName FAutomationGraphTestImpact::GetTestPackageName(const FAutomationTestInfo& TestInfo) const
+{
+	for (const FString& Candidate : {TestInfo.GetAssetPath(), TestInfo.GetTestParameter()})
+	{
+		if (Candidate.IsEmpty())
+		{
+			continue;
+		}
+
+		FString PackageName;
+		if (FPackageName::IsValidObjectPath(Candidate))
+		{
+			PackageName = FPackageName::ObjectPathToPackageName(Candidate);
+		}
+		else if (FPackageName::IsValidLongPackageName(Candidate))
+		{
+			PackageName = Candidate;
+		}
+		else if (!FPackageName::TryConvertFilenameToLongPackageName(Candidate, PackageName))
+		{
+			continue;
+		}
+
+		return FName(*PackageName);
+	}
+
+	return NAME_None;
+}
@@ -0,0 +1,202 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Foundation/AutomationGraphTestResultsWriter.h"
+
+#include "AutomationGraphEditorLoggingDefs.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformFileManager.h"
+#include "Macros/AutomationGraphLoggingMacros.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	const FString JUnitFooter = TEXT("\t</testsuite>\n</testsuites>\n");
+
+	// Enough for three 10 digit counts, plus their attribute names.
+	constexpr int32 CountsWidth = 64;
+
+	FString EscapeXml(const FString& Text)
+	{
+		return Text
+			.Replace(TEXT("&"), TEXT("&amp;"))
+			.Replace(TEXT("<"), TEXT("&lt;"))
+			.Replace(TEXT(">"), TEXT("&gt;"))
+			.Replace(TEXT("\""), TEXT("&quot;"))
+			.Replace(TEXT("'"), TEXT("&apos;"));
+	}
+}
+
+bool FAutomationGraphTestResultsWriter::Open(const FString& Directory, const FString& SuiteName)
+{
+	Close();
+
+	IFileManager& FileManager = IFileManager::Get();
+	FileManager.MakeDirectory(*Directory, true);
+
+	const FString JUnitPath = FPaths::Combine(Directory, TEXT("Results.xml"));
+	const FString JsonPath = FPaths::Combine(Directory, TEXT("Results.jsonl"));
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	JUnitFile.Reset(PlatformFile.OpenWrite(*JUnitPath, false, true));
+	JsonFile.Reset(PlatformFile.OpenWrite(*JsonPath, false, true));
+	
+	if (!JUnitFile.IsValid() || !JsonFile.IsValid())
+	{
+		AG_LOG(LogAutoGraphEditor, Error, TEXT("Failed to open test results in %s"), *Directory);
+		Close();
+		return false;
+	}
+
+	NumTests = 0;
+	NumFailures = 0;
+	NumSkipped = 0;
+
+	const FString SuiteHeader = FString::Printf(
+		TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites name=\"%s\">\n\t<testsuite name=\"%s\" timestamp=\"%s\""),
+		*EscapeXml(SuiteName), *EscapeXml(SuiteName), *FDateTime::UtcNow().ToIso8601());
+	WriteUTF8(*JUnitFile, SuiteHeader);
+	CountsOffset = JUnitFile->Tell();
+	WriteCounts();
+	WriteUTF8(*JUnitFile, TEXT(">\n"));
+	WriteUTF8(*JUnitFile, JUnitFooter);
+	JUnitFile->Flush();
+
+	return true;
+}
+
+void FAutomationGraphTestResultsWriter::Close()
+{
+	JUnitFile.Reset();
+	JsonFile.Reset();
+}
+
+void FAutomationGraphTestResultsWriter::AddResult(const FString& TestPath, bool bPassed, float DurationSec, const TArray<FString>& Errors)
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	NumTests++;
+	FString Body;
+	if (!bPassed)
+	{
+		NumFailures++;
+		const FString Message = Errors.IsEmpty() ? FString(TEXT("Test failed")) : Errors[0];
+		Body = FString::Printf(TEXT("\t\t\t<failure message=\"%s\">%s</failure>\n"), *EscapeXml(Message), *EscapeXml(FString::Join(Errors, TEXT("\n"))));
+	}
+
+	WriteTestCase(TestPath, bPassed ? TEXT("Success") : TEXT("Fail"), DurationSec, Body, Errors, FString());
+}
+
+void FAutomationGraphTestResultsWriter::AddSkipped(const FString& TestPath, const FString& Reason)
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	NumTests++;
+	NumSkipped++;
+	WriteTestCase(TestPath, TEXT("Skipped"), 0.0f, FString::Printf(TEXT("\t\t\t<skipped message=\"%s\"/>\n"), *EscapeXml(Reason)), {}, Reason);
+}
+
+void FAutomationGraphTestResultsWriter::WriteTestCase(const FString& TestPath, const FString& State, float DurationSec, const FString& Body, const TArray<FString>& Errors, const FString& Reason)
+{
+	// JUnit has no notion of a test path, so split it into the usual class name and test name.
+	FString ClassName;
+	FString TestName = TestPath;
+	TestPath.Split(TEXT("."), &ClassName, &TestName, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+
+	FString TestCase = FString::Printf(TEXT("\t\t<testcase classname=\"%s\" name=\"%s\" time=\"%.3f\""), *EscapeXml(ClassName), *EscapeXml(TestName), FMath::Max(DurationSec, 0.0f));
+	if (Body.IsEmpty())
+	{
+		TestCase += TEXT("/>\n");
+	}
+	else
+	{
+		TestCase += FString::Printf(TEXT(">\n%s\t\t</testcase>\n"), *Body);
+	}
+
+	// Overwrite the closing tags, then put them back after the new test case.
+	JUnitFile->Seek(JUnitFile->Size() - FTCHARToUTF8(*JUnitFooter).Length());
+	WriteUTF8(*JUnitFile, TestCase);
+	WriteUTF8(*JUnitFile, JUnitFooter);
+	WriteCounts();
+	JUnitFile->Flush();
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetStringField(TEXT("test"), TestPath);
+	Result->SetStringField(TEXT("state"), State);
+	Result->SetNumberField(TEXT("durationSec"), DurationSec);
+
+	TArray<TSharedPtr<FJsonValue>> ErrorValues;
+	for (const FString& Error : Errors)
+	{
+		ErrorValues.Add(MakeShared<FJsonValueString>(Error));
+	}
+	Result->SetArrayField(TEXT("errors"), ErrorValues);
+
+	// Why a test was skipped. It isn't an error, so it's kept out of the errors list.
+	if (!Reason.IsEmpty())
+	{
+		Result->SetStringField(TEXT("reason"), Reason);
+	}
+
+	FString ResultLine;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ResultLine);
+	FJsonSerializer::Serialize(Result, Writer);
+	
+	WriteUTF8(*JsonFile, ResultLine + TEXT("\n"));
+	JsonFile->Flush();
+}
+
+void FAutomationGraphTestResultsWriter::WriteCounts()
+{
+	// Whitespace before the end of a tag is valid XML, so the padding keeps the file well formed.
+	const bool bAtEnd = JUnitFile->Tell() > CountsOffset;
+	JUnitFile->Seek(CountsOffset);
+	WriteUTF8(*JUnitFile, FString::Printf(TEXT(" tests=\"%d\" failures=\"%d\" skipped=\"%d\""), NumTests, NumFailures, NumSkipped).RightPad(CountsWidth));
+	if (bAtEnd)
+	{
+		JUnitFile->Seek(JUnitFile->Size());
+	}
+}
+
+void FAutomationGraphTestResultsWriter::WriteUTF8(IFileHandle& File, const FString& Text)
+{
+	FTCHARToUTF8 UTF8Text(*Text);
+	File.Write(reinterpret_cast<const uint8*>(UTF8Text.Get()), UTF8Text.Length());
+}
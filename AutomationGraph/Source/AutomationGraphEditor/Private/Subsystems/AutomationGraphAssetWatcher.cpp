@@ -0,0 +1,173 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Subsystems/AutomationGraphAssetWatcher.h"
+
+#include "AutomationGraphEditorLoggingDefs.h"
+#include "Editor.h"
+#include "AutomationNodes/TriggerOnAssetChange.h"
+#include "Foundation/AutomationGraph.h"
+#include "Subsystems/ImportSubsystem.h"
+#include "UObject/ObjectSaveContext.h"
+
+FAutomationGraphAssetWatcher::~FAutomationGraphAssetWatcher()
+{
+	Stop();
+}
+
+void FAutomationGraphAssetWatcher::Start()
+{
+	if (PackageSavedHandle.IsValid())
+	{
+		return;
+	}
+	
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FAutomationGraphAssetWatcher::OnPackageSaved);
+	
+	if (UImportSubsystem* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+	{
+		AssetPostImportHandle = ImportSubsystem->OnAssetPostImport.AddRaw(this, &FAutomationGraphAssetWatcher::OnAssetPostImport);
+		AssetReimportHandle = ImportSubsystem->OnAssetReimport.AddRaw(this, &FAutomationGraphAssetWatcher::OnAssetReimport);
+	}
+}
+
+void FAutomationGraphAssetWatcher::Stop()
+{
+	if (!PackageSavedHandle.IsValid())
+	{
+		return;
+	}
+	
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	PackageSavedHandle.Reset();
+	
+	if (UImportSubsystem* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+	{
+		ImportSubsystem->OnAssetPostImport.Remove(AssetPostImportHandle);
+		ImportSubsystem->OnAssetReimport.Remove(AssetReimportHandle);
+	}
+	AssetPostImportHandle.Reset();
+	AssetReimportHandle.Reset();
+
+	TriggerNodes.Empty();
+	PendingChanges.Reset();
+}
+
+void FAutomationGraphAssetWatcher::WatchGraph(UAutomationGraph* Graph)
+{
+	if (!Graph)
+	{
+		return;
+	}
+
+	UnwatchGraph(Graph);
+
+	TArray<TWeakObjectPtr<UAGN_TriggerOnAssetChange>> GraphTriggers;
+	for (UAutomationGraphNode* RootNode : Graph->RootNodes)
+	{
+		if (auto* TriggerNode = Cast<UAGN_TriggerOnAssetChange>(RootNode))
+		{
+			GraphTriggers.Add(TriggerNode);
+		}
+	}
+
+	if (!GraphTriggers.IsEmpty())
+	{
+		TriggerNodes.Add(Graph, MoveTemp(GraphTriggers));
+	}
+}
+
+void FAutomationGraphAssetWatcher::UnwatchGraph(UAutomationGraph* Graph)
+{
+	TArray<TWeakObjectPtr<UAGN_TriggerOnAssetChange>> GraphTriggers;
+	if (!TriggerNodes.RemoveAndCopyValue(Graph, GraphTriggers))
+	{
+		return;
+	}
+
+	for (TWeakObjectPtr<UAGN_TriggerOnAssetChange> TriggerNode : GraphTriggers)
+	{
+		PendingChanges.Remove(TriggerNode);
+	}
+}
+
+TArray<UAutomationGraph*> FAutomationGraphAssetWatcher::FlushChanges(double CurrentTime)
+{
+	return PendingChanges.Flush(CurrentTime, [](UAutomationGraph* Graph, UAGN_TriggerOnAssetChange* TriggerNode, const TArray<FSoftObjectPath>& Assets)
+	{
+		UE_LOG(LogAutoGraphEditor, Log, TEXT("%s: %d asset(s) changed."), *Graph->GetName(), Assets.Num());
+		TriggerNode->AddChangedAssets(Assets);
+	});
+}
+
+void FAutomationGraphAssetWatcher::OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	if (TriggerNodes.IsEmpty() || !Package || ObjectSaveContext.IsProceduralSave() || (ObjectSaveContext.GetSaveFlags() & SAVE_FromAutosave))
+	{
+		return;
+	}
+
+	AddChangedAsset(Package->FindAssetInPackage(), false);
+}
+
+void FAutomationGraphAssetWatcher::OnAssetPostImport(UFactory* Factory, UObject* Asset)
+{
+	AddChangedAsset(Asset, true);
+}
+
+void FAutomationGraphAssetWatcher::OnAssetReimport(UObject* Asset)
+{
+	AddChangedAsset(Asset, true);
+}
+
+void FAutomationGraphAssetWatcher::AddChangedAsset(UObject* Asset, bool bImported)
+{
+	// Editing a graph must not trigger graphs, including itself.
+	if (!Asset || Asset->IsA<UAutomationGraph>())
+	{
+		return;
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	for (const TPair<TWeakObjectPtr<UAutomationGraph>, TArray<TWeakObjectPtr<UAGN_TriggerOnAssetChange>>>& GraphTriggers : TriggerNodes)
+	{
+		for (TWeakObjectPtr<UAGN_TriggerOnAssetChange> WeakTriggerNode : GraphTriggers.Value)
+		{
+			UAGN_TriggerOnAssetChange* TriggerNode = WeakTriggerNode.Get();
+			if (!TriggerNode || !(bImported ? TriggerNode->bTriggerOnImport : TriggerNode->bTriggerOnSave) || !TriggerNode->MatchesAsset(Asset))
+			{
+				continue;
+			}
+
+			PendingChanges.AddChange(TriggerNode, GraphTriggers.Key.Get(), FSoftObjectPath(Asset), CurrentTime);
+		}
+	}
+}
@@ -0,0 +1,173 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Subsystems/AutomationGraphFileWatcher.h"
+
+#include "AutomationGraphEditorLoggingDefs.h"
+#include "DirectoryWatcherModule.h"
+#include "AutomationNodes/TriggerOnFileChange.h"
+#include "Foundation/AutomationGraph.h"
+#include "Misc/Paths.h"
+
+FAutomationGraphFileWatcher::~FAutomationGraphFileWatcher()
+{
+	Reset();
+}
+
+void FAutomationGraphFileWatcher::WatchGraph(UAutomationGraph* Graph)
+{
+	if (!Graph)
+	{
+		return;
+	}
+
+	UnwatchGraph(Graph);
+	
+	IDirectoryWatcher* DirectoryWatcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")).Get();
+	if (!DirectoryWatcher)
+	{
+		return;
+	}
+
+	TArray<FWatch> GraphWatches;
+	for (UAutomationGraphNode* RootNode : Graph->RootNodes)
+	{
+		auto* TriggerNode = Cast<UAGN_TriggerOnFileChange>(RootNode);
+		if (!TriggerNode)
+		{
+			continue;
+		}
+
+		for (const FString& Directory : TriggerNode->GetWatchedDirectories())
+		{
+			FWatch& Watch = GraphWatches.AddDefaulted_GetRef();
+			Watch.Node = TriggerNode;
+			Watch.Directory = Directory;
+
+			const uint32 WatchFlags = TriggerNode->bIncludeSubdirectories ? 0 : IDirectoryWatcher::WatchOptions::IgnoreChangesInSubtree;
+			auto Callback = IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FAutomationGraphFileWatcher::OnDirectoryChanged, Watch.Node, Directory);
+			if (!DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(Directory, Callback, Watch.Handle, WatchFlags))
+			{
+				UE_LOG(LogAutoGraphEditor, Warning, TEXT("%s: Failed to watch %s."), *Graph->GetName(), *Directory);
+				GraphWatches.Pop();
+			}
+		}
+	}
+
+	if (!GraphWatches.IsEmpty())
+	{
+		UE_LOG(LogAutoGraphEditor, Log, TEXT("%s: Watching %d directories for file changes."), *Graph->GetName(), GraphWatches.Num());
+		Watches.Add(Graph, MoveTemp(GraphWatches));
+	}
+}
+
+void FAutomationGraphFileWatcher::UnwatchGraph(UAutomationGraph* Graph)
+{
+	TArray<FWatch> GraphWatches;
+	if (!Watches.RemoveAndCopyValue(Graph, GraphWatches))
+	{
+		return;
+	}
+
+	IDirectoryWatcher* DirectoryWatcher = GetDirectoryWatcher();
+	for (const FWatch& Watch : GraphWatches)
+	{
+		if (DirectoryWatcher)
+		{
+			DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(Watch.Directory, Watch.Handle);
+		}
+		PendingChanges.Remove(Watch.Node);
+	}
+}
+
+void FAutomationGraphFileWatcher::Reset()
+{
+	IDirectoryWatcher* DirectoryWatcher = GetDirectoryWatcher();
+	if (DirectoryWatcher)
+	{
+		for (const TPair<TWeakObjectPtr<UAutomationGraph>, TArray<FWatch>>& GraphWatches : Watches)
+		{
+			for (const FWatch& Watch : GraphWatches.Value)
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(Watch.Directory, Watch.Handle);
+			}
+		}
+	}
+	
+	Watches.Empty();
+	PendingChanges.Reset();
+}
+
+TArray<UAutomationGraph*> FAutomationGraphFileWatcher::FlushChanges(double CurrentTime)
+{
+	return PendingChanges.Flush(CurrentTime, [](UAutomationGraph* Graph, UAGN_TriggerOnFileChange* TriggerNode, const TArray<FString>& Files)
+	{
+		UE_LOG(LogAutoGraphEditor, Log, TEXT("%s: %d file(s) changed."), *Graph->GetName(), Files.Num());
+		TriggerNode->AddChangedFiles(Files);
+	});
+}
+
+void FAutomationGraphFileWatcher::OnDirectoryChanged(const TArray<FFileChangeData>& Changes, TWeakObjectPtr<UAGN_TriggerOnFileChange> WeakNode, FString Directory)
+{
+	UAGN_TriggerOnFileChange* TriggerNode = WeakNode.Get();
+	if (!TriggerNode)
+	{
+		return;
+	}
+
+	// Trigger nodes are always outered to their graph, except while they are being copied in the editor.
+	UAutomationGraph* Graph = TriggerNode->GetTypedOuter<UAutomationGraph>();
+	if (!Graph)
+	{
+		return;
+	}
+
+	const FString DirectoryPrefix = Directory / TEXT("");
+	const double CurrentTime = FPlatformTime::Seconds();
+	
+	for (const FFileChangeData& Change : Changes)
+	{
+		FString Filename = FPaths::ConvertRelativePathToFull(Change.Filename);
+		if (!Filename.StartsWith(DirectoryPrefix) || !TriggerNode->MatchesFilters(Filename.RightChop(DirectoryPrefix.Len())))
+		{
+			continue;
+		}
+
+		PendingChanges.AddChange(TriggerNode, Graph, MoveTemp(Filename), CurrentTime);
+	}
+}
+
+IDirectoryWatcher* FAutomationGraphFileWatcher::GetDirectoryWatcher()
+{
+	// The module may already be unloaded during shutdown, which also removes its watches.
+	FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+	return DirectoryWatcherModule ? DirectoryWatcherModule->Get() : nullptr;
+}
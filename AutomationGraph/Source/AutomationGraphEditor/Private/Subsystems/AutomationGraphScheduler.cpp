@@ -0,0 +1,166 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Subsystems/AutomationGraphScheduler.h"
+
+#include "AutomationGraphEditorLoggingDefs.h"
+#include "AutomationNodes/TriggerOnSchedule.h"
+#include "Foundation/AutomationGraph.h"
+#include "Framework/Application/SlateApplication.h"
+
+void FAutomationGraphScheduler::WatchGraph(UAutomationGraph* Graph)
+{
+	if (!Graph)
+	{
+		return;
+	}
+
+	UnwatchGraph(Graph);
+
+	const FDateTime Now = FDateTime::Now();
+	for (UAutomationGraphNode* RootNode : Graph->RootNodes)
+	{
+		auto* TriggerNode = Cast<UAGN_TriggerOnSchedule>(RootNode);
+		if (!TriggerNode)
+		{
+			continue;
+		}
+
+		FScheduledTrigger Trigger;
+		Trigger.Node = TriggerNode;
+		Trigger.Graph = Graph;
+		Trigger.Deadline = TriggerNode->GetNextRunTime(Now);
+		if (Trigger.Deadline == FDateTime::MaxValue())
+		{
+			continue;
+		}
+		
+		UE_LOG(LogAutoGraphEditor, Log, TEXT("%s: Next scheduled run at %s."), *Graph->GetName(), *Trigger.Deadline.ToString());
+		Schedule(Trigger);
+	}
+}
+
+void FAutomationGraphScheduler::UnwatchGraph(UAutomationGraph* Graph)
+{
+	const int32 NumRemoved = DeadlineHeap.RemoveAll([Graph](const FScheduledTrigger& Trigger)
+	{
+		return Trigger.Graph == Graph;
+	});
+
+	if (NumRemoved > 0)
+	{
+		DeadlineHeap.Heapify(DeadlineLess);
+		UpdateNextWakeTime();
+	}
+}
+
+void FAutomationGraphScheduler::Reset()
+{
+	DeadlineHeap.Empty();
+	UpdateNextWakeTime();
+}
+
+TArray<UAutomationGraph*> FAutomationGraphScheduler::FlushDue(double CurrentTime)
+{
+	TArray<UAutomationGraph*> DueGraphs;
+	if (CurrentTime < NextWakeTime)
+	{
+		return DueGraphs;
+	}
+
+	const FDateTime Now = FDateTime::Now();
+	TArray<FScheduledTrigger> Rescheduled;
+	
+	while (!DeadlineHeap.IsEmpty() && DeadlineHeap.HeapTop().Deadline <= Now)
+	{
+		FScheduledTrigger Trigger;
+		DeadlineHeap.HeapPop(Trigger, DeadlineLess);
+
+		UAGN_TriggerOnSchedule* TriggerNode = Trigger.Node.Get();
+		UAutomationGraph* Graph = Trigger.Graph.Get();
+		if (!TriggerNode || !Graph)
+		{
+			continue;
+		}
+
+		if (TriggerNode->bOnlyWhenIdle && FSlateApplication::IsInitialized())
+		{
+			const double IdleTime = CurrentTime - FSlateApplication::Get().GetLastUserInteractionTime();
+			if (IdleTime < TriggerNode->IdleSec)
+			{
+				// Check again once the user could have been idle for long enough.
+				Trigger.Deadline = Now + FTimespan::FromSeconds(TriggerNode->IdleSec - IdleTime);
+				Rescheduled.Add(Trigger);
+				continue;
+			}
+		}
+
+		// The next deadline is computed from now rather than from the missed one, so time spent asleep or in a long run
+		// doesn't turn into a backlog of runs.
+		DueGraphs.AddUnique(Graph);
+		Trigger.Deadline = TriggerNode->GetNextRunTime(Now);
+		if (Trigger.Deadline != FDateTime::MaxValue())
+		{
+			Rescheduled.Add(Trigger);
+		}
+	}
+
+	for (const FScheduledTrigger& Trigger : Rescheduled)
+	{
+		DeadlineHeap.HeapPush(Trigger, DeadlineLess);
+	}
+	UpdateNextWakeTime();
+	
+	return DueGraphs;
+}
+
+bool FAutomationGraphScheduler::DeadlineLess(const FScheduledTrigger& A, const FScheduledTrigger& B)
+{
+	return A.Deadline < B.Deadline;
+}
+
+void FAutomationGraphScheduler::Schedule(const FScheduledTrigger& Trigger)
+{
+	DeadlineHeap.HeapPush(Trigger, DeadlineLess);
+	UpdateNextWakeTime();
+}
+
+void FAutomationGraphScheduler::UpdateNextWakeTime()
+{
+	if (DeadlineHeap.IsEmpty())
+	{
+		NextWakeTime = TNumericLimits<double>::Max();
+		return;
+	}
+
+	const double SecondsUntilDeadline = (DeadlineHeap.HeapTop().Deadline - FDateTime::Now()).GetTotalSeconds();
+	NextWakeTime = FPlatformTime::Seconds() + FMath::Max(SecondsUntilDeadline, 0.0);
+}
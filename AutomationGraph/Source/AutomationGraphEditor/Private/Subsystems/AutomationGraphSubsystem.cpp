@@ -37,12 +37,38 @@
 #include "Foundation/AutomationGraph.h"
 #include "Foundation/AutomationGraphNode.h"
 #include "Foundation/AutomationGraphExecutor.h"
+#include "HAL/IConsoleManager.h"
 #include "UnrealEdGlobals.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/UObjectHash.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "EdGraph/EdGraph_AutomationGraph.h"
 #include "AutomationNodes/RunTests.h"
+#include "AutomationNodes/TriggerOnAssetChange.h"
+#include "AutomationNodes/TriggerOnFileChange.h"
+#include "AutomationNodes/TriggerOnSchedule.h"
 #include "Macros/AutomationGraphLoggingMacros.h"
+#include "Subsystems/AutomationGraphRunHandle.h"
+#include "Subsystems/ImportSubsystem.h"
 #include "Subsystems/UnrealEditorSubsystem.h"
 
+static TAutoConsoleVariable<int32> CVarPreemptBackgroundRuns(
+	TEXT("AutomationGraph.PreemptBackgroundRuns"),
+	0,
+	TEXT("What happens to background runs while an interactive run is queued or running.\n")
+	TEXT("0: Nothing. They keep running alongside it.\n")
+	TEXT("1: Running background graphs are paused, and queued ones wait.\n")
+	TEXT("2: Running background graphs are cancelled and queued again, and queued ones wait.")
+);
+
+static TAutoConsoleVariable<int32> CVarMaxConcurrentRuns(
+	TEXT("AutomationGraph.MaxConcurrentRuns"),
+	0,
+	TEXT("Maximum number of graphs that can run at once. Queued graphs start in priority order as runs finish.\n")
+	TEXT("0: No limit. Every queued graph whose dependencies are met starts right away, so priority only matters if\n")
+	TEXT("AutomationGraph.PreemptBackgroundRuns is set.")
+);
+
 UAGN_RunTests::UAGN_RunTests(const FObjectInitializer& Initializer): Super(Initializer)
 {
 	Title = FText::FromString("Run Tests");
@@ -55,7 +81,7 @@ void UAutomationGraphSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	for (TObjectIterator<UClass> ClassIterator; ClassIterator; ++ClassIterator)
 	{
 		UClass* Class = *ClassIterator;
-		if (!ClassIterator->IsChildOf(UAutomationGraphNode::StaticClass()) || Class->HasAnyClassFlags(CLASS_Abstract))
+		if (!ClassIterator->IsChildOf(UAutomationGraphNode::StaticClass()) || Class->HasAnyClassFlags(CLASS_Abstract | CLASS_HideDropDown))
 		{
 			continue;
 		}
@@ -67,12 +93,50 @@ void UAutomationGraphSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	auto* AutomationControllerModule = &FModuleManager::LoadModuleChecked<IAutomationControllerModule>("AutomationController");
 	AutomationController = AutomationControllerModule->GetAutomationController();
 
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	AssetRegistryModule.Get().OnFilesLoaded().AddUObject(this, &ThisClass::EnqueueStartupGraphs);
+	bIsTestWorker = UAGN_RunTests::IsTestWorker();
+	if (bIsTestWorker)
+	{
+		UE_LOG(LogAutomationGraphSubsystem, Log, TEXT("Running as a test worker. Startup graphs and triggers are disabled"));
+	}
+	else
+	{
+		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+		AssetRegistryModule.Get().OnFilesLoaded().AddUObject(this, &ThisClass::EnqueueStartupGraphs);
+	}
+
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &ThisClass::OnObjectPropertyChanged);
+	ObjectPreSaveHandle = FCoreUObjectDelegates::OnObjectPreSave.AddUObject(this, &ThisClass::OnObjectPreSave);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddUObject(this, &ThisClass::OnPackageSaved);
+
+	Collection.InitializeDependency<UImportSubsystem>();
+	if (!bIsTestWorker)
+	{
+		AssetWatcher.Start();
+	}
 }
 
 void UAutomationGraphSubsystem::Deinitialize()
 {
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+	FCoreUObjectDelegates::OnObjectPreSave.Remove(ObjectPreSaveHandle);
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	FileWatcher.Reset();
+	AssetWatcher.Stop();
+	Scheduler.Reset();
+
+	// Nothing will run after this, so release anyone waiting on a handle.
+	FGraphRunSubmission Submission;
+	while (Submissions.Dequeue(Submission))
+	{
+		Submission.RunState->Complete(false);
+	}
+	for (TPair<TWeakObjectPtr<UAutomationGraph>, FQueuedGraphTask>& RunningTask : RunningTasks)
+	{
+		CompleteTask(RunningTask.Value, false);
+	}
+	RunningTasks.Empty();
+	ClearTaskQueue();
+	
 	Super::Deinitialize();
 }
 
@@ -107,22 +171,377 @@ bool UAutomationGraphSubsystem::IsAllowedToTick() const
 
 void UAutomationGraphSubsystem::Tick(float DeltaSeconds)
 {
-	// check if we are mid-execution
-	if (CurrentExecutor && CurrentExecutor->Execute(DeltaSeconds))
+	if (!PendingWatchChanges.IsEmpty())
 	{
-		return;
+		WatchDebounceTimer -= DeltaSeconds;
+		if (WatchDebounceTimer <= 0.0f)
+		{
+			FlushWatchChanges();
+		}
+	}
+	
+	DrainSubmissions();
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	for (UAutomationGraph* Graph : FileWatcher.FlushChanges(CurrentTime))
+	{
+		EnqueueAutomationGraph(Graph, EAutomationGraphNodeTrigger::OnFileChange);
+	}
+	for (UAutomationGraph* Graph : AssetWatcher.FlushChanges(CurrentTime))
+	{
+		EnqueueAutomationGraph(Graph, EAutomationGraphNodeTrigger::OnAssetChange);
 	}
-	CurrentExecutor = nullptr;
 
-	while(TaskQueue.Num() > 0)
+	// A graph that is already queued absorbs the new run, so a schedule never piles up more than one pending run.
+	for (UAutomationGraph* Graph : Scheduler.FlushDue(CurrentTime))
 	{
-		if (TaskQueue[0].TargetGraph.IsValid())
+		EnqueueAutomationGraph(Graph, EAutomationGraphNodeTrigger::OnSchedule);
+	}
+	
+	PromoteDependencies();
+
+	const int32 PreemptionMode = CVarPreemptBackgroundRuns.GetValueOnGameThread();
+	const bool bHoldBackgroundRuns = PreemptionMode > 0 && HasInteractiveTasks();
+	
+	for (int32 ExecutorIndex = 0; ExecutorIndex < RunningExecutors.Num();)
+	{
+		UAutomationGraphExecutor* Executor = RunningExecutors[ExecutorIndex];
+		UAutomationGraph* Graph = Executor->GetTargetGraph();
+		const FQueuedGraphTask* RunningTask = RunningTasks.Find(Graph);
+		
+		if (bHoldBackgroundRuns && RunningTask && RunningTask->Priority == EAutomationGraphTaskPriority::Background)
+		{
+			if (PreemptionMode == 1)
+			{
+				++ExecutorIndex;
+				continue;
+			}
+
+			UE_LOG(LogAutomationGraphSubsystem, Log, TEXT("%s: Preempted by an interactive run. It will be run again afterwards."), *Graph->GetName());
+			FQueuedGraphTask PreemptedTask = *RunningTask;
+			RunningTasks.Remove(Graph);
+			Executor->Cancel(Graph);
+			RunningExecutors.RemoveAt(ExecutorIndex);
+			IdleExecutors.Add(Executor);
+
+			// A queued run of the same graph replaces the preempted one, unless the preempted run was a full run.
+			if (FQueuedGraphTask* QueuedTask = TaskQueue.Find(Graph))
+			{
+				if (PreemptedTask.Task.DirtyNodes.IsEmpty())
+				{
+					QueuedTask->Task.DirtyNodes.Empty();
+				}
+				QueuedTask->Task.MergeTrigger(PreemptedTask.Task.Trigger);
+				for (EAutomationGraphNodeTrigger MergedTrigger : PreemptedTask.Task.MergedTriggers)
+				{
+					QueuedTask->Task.MergeTrigger(MergedTrigger);
+				}
+				QueuedTask->RunStates.Append(PreemptedTask.RunStates);
+			}
+			else
+			{
+				TaskQueue.Add(Graph, PreemptedTask);
+			}
+			continue;
+		}
+		
+		if (Executor->Execute(DeltaSeconds))
+		{
+			++ExecutorIndex;
+			continue;
+		}
+
+		if (Graph)
 		{
-			StartExecution(TaskQueue[0]);
+			LastRunResults.Add(Graph, Executor->DidLastRunSucceed());
+			
+			FQueuedGraphTask FinishedTask;
+			if (RunningTasks.RemoveAndCopyValue(Graph, FinishedTask))
+			{
+				CompleteTask(FinishedTask, Executor->DidLastRunSucceed());
+			}
+		}
+		else
+		{
+			// The executor reset itself because its graph went away.
+			for (auto TaskIterator = RunningTasks.CreateIterator(); TaskIterator; ++TaskIterator)
+			{
+				if (!TaskIterator.Key().IsValid())
+				{
+					CompleteTask(TaskIterator.Value(), false);
+					TaskIterator.RemoveCurrent();
+				}
+			}
 		}
 		
-		TaskQueue.RemoveAt(0);
+		RunningExecutors.RemoveAt(ExecutorIndex);
+		IdleExecutors.Add(Executor);
+	}
+
+	StartReadyTasks(bHoldBackgroundRuns);
+}
+
+void UAutomationGraphSubsystem::StartReadyTasks(bool bHoldBackgroundRuns)
+{
+	// Higher priorities first. Tasks with the same priority start in the order they were enqueued.
+	TArray<FQueuedGraphTask> OrderedTasks;
+	TaskQueue.GenerateValueArray(OrderedTasks);
+	OrderedTasks.Sort([](const FQueuedGraphTask& A, const FQueuedGraphTask& B)
+	{
+		return A.Priority != B.Priority ? A.Priority > B.Priority : A.Sequence < B.Sequence;
+	});
+
+	// Background runs that are being held back are paused, so they don't count toward the limit. Otherwise they could
+	// keep out the interactive run they are waiting on.
+	const int32 MaxConcurrentRuns = CVarMaxConcurrentRuns.GetValueOnGameThread();
+	int32 NumActiveRuns = 0;
+	for (const TPair<TWeakObjectPtr<UAutomationGraph>, FQueuedGraphTask>& RunningTask : RunningTasks)
+	{
+		if (!bHoldBackgroundRuns || RunningTask.Value.Priority != EAutomationGraphTaskPriority::Background)
+		{
+			NumActiveRuns++;
+		}
+	}
+	
+	for (FQueuedGraphTask& QueuedTask : OrderedTasks)
+	{
+		UAutomationGraph* Graph = QueuedTask.Task.TargetGraph.Get();
+		if (!Graph)
+		{
+			TaskQueue.Remove(QueuedTask.Task.TargetGraph);
+			CompleteTask(QueuedTask, false);
+			continue;
+		}
+
+		if (bHoldBackgroundRuns && QueuedTask.Priority == EAutomationGraphTaskPriority::Background)
+		{
+			continue;
+		}
+
+		// A graph can only have one run at a time.
+		EDependencyState State = FindRunningExecutor(Graph) ? EDependencyState::Waiting : GetDependencyState(Graph);
+		if (State == EDependencyState::Waiting)
+		{
+			continue;
+		}
+
+		if (State == EDependencyState::Failed)
+		{
+			UE_LOG(LogAutomationGraphSubsystem, Error, TEXT("%s: A dependency did not finish. Skipping this run."), *Graph->GetName());
+			TaskQueue.Remove(Graph);
+
+			// Anything that depends on this graph is skipped as well.
+			LastRunResults.Add(Graph, false);
+			CompleteTask(QueuedTask, false);
+			continue;
+		}
+
+		// Skipped tasks above don't take up a run, so keep going rather than stopping at the first task that doesn't fit.
+		if (MaxConcurrentRuns > 0 && NumActiveRuns >= MaxConcurrentRuns)
+		{
+			continue;
+		}
+
+		TaskQueue.Remove(Graph);
+		if (StartExecution(QueuedTask))
+		{
+			NumActiveRuns++;
+		}
+	}
+}
+
+void UAutomationGraphSubsystem::PromoteDependencies()
+{
+	// An interactive run must not wait on a background run that is being held back, so everything it waits on (its
+	// dependencies, or an earlier run of the same graph) inherits its priority.
+	TArray<UAutomationGraph*> GraphStack;
+	for (const TPair<TWeakObjectPtr<UAutomationGraph>, FQueuedGraphTask>& QueuedTask : TaskQueue)
+	{
+		if (QueuedTask.Value.Priority == EAutomationGraphTaskPriority::Interactive)
+		{
+			GraphStack.Add(QueuedTask.Key.Get());
+		}
+	}
+	for (const TPair<TWeakObjectPtr<UAutomationGraph>, FQueuedGraphTask>& RunningTask : RunningTasks)
+	{
+		if (RunningTask.Value.Priority == EAutomationGraphTaskPriority::Interactive)
+		{
+			GraphStack.Add(RunningTask.Key.Get());
+		}
+	}
+
+	TSet<UAutomationGraph*> Visited;
+	while (!GraphStack.IsEmpty())
+	{
+		UAutomationGraph* Graph = GraphStack.Pop();
+		if (!Graph || Visited.Contains(Graph))
+		{
+			continue;
+		}
+
+		Visited.Add(Graph);
+		if (FQueuedGraphTask* RunningTask = RunningTasks.Find(Graph))
+		{
+			RunningTask->Priority = EAutomationGraphTaskPriority::Interactive;
+		}
+		
+		for (const FAutomationGraphDependency& Dependency : Graph->Dependencies)
+		{
+			UAutomationGraph* Prerequisite = Dependency.Graph.Get();
+			if (FQueuedGraphTask* QueuedTask = TaskQueue.Find(Prerequisite))
+			{
+				QueuedTask->Priority = EAutomationGraphTaskPriority::Interactive;
+			}
+			GraphStack.Add(Prerequisite);
+		}
+	}
+}
+
+bool UAutomationGraphSubsystem::HasInteractiveTasks() const
+{
+	for (const TPair<TWeakObjectPtr<UAutomationGraph>, FQueuedGraphTask>& QueuedTask : TaskQueue)
+	{
+		if (QueuedTask.Value.Priority == EAutomationGraphTaskPriority::Interactive)
+		{
+			return true;
+		}
+	}
+	for (const TPair<TWeakObjectPtr<UAutomationGraph>, FQueuedGraphTask>& RunningTask : RunningTasks)
+	{
+		if (RunningTask.Value.Priority == EAutomationGraphTaskPriority::Interactive)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+UAutomationGraphSubsystem::EDependencyState UAutomationGraphSubsystem::GetDependencyState(const UAutomationGraph* Graph) const
+{
+	EDependencyState State = EDependencyState::Ready;
+	for (const FAutomationGraphDependency& Dependency : Graph->Dependencies)
+	{
+		switch (GetDependencyState(Graph, Dependency))
+		{
+		case EDependencyState::Failed:
+			return EDependencyState::Failed;
+		case EDependencyState::Waiting:
+			State = EDependencyState::Waiting;
+			break;
+		default:
+			break;
+		}
+	}
+
+	return State;
+}
+
+UAutomationGraphSubsystem::EDependencyState UAutomationGraphSubsystem::GetDependencyState(const UAutomationGraph* Graph, const FAutomationGraphDependency& Dependency) const
+{
+	// Graphs that aren't loaded can't be queued or running.
+	UAutomationGraph* Prerequisite = Dependency.Graph.Get();
+	if (!Prerequisite)
+	{
+		return EDependencyState::Ready;
+	}
+
+	UAutomationGraphNode* PrerequisiteNode = nullptr;
+	if (!Dependency.NodeName.IsEmpty())
+	{
+		PrerequisiteNode = Prerequisite->FindNode(Dependency.NodeName);
+		if (!PrerequisiteNode)
+		{
+			UE_LOG(LogAutomationGraphSubsystem, Error, TEXT("%s: Dependency node %s does not exist in %s."), *Graph->GetName(), *Dependency.NodeName, *Prerequisite->GetName());
+			return EDependencyState::Failed;
+		}
+	}
+
+	if (FindRunningExecutor(Prerequisite))
+	{
+		if (!PrerequisiteNode)
+		{
+			return EDependencyState::Waiting;
+		}
+
+		// Node dependencies are released as soon as the node finishes, even if the rest of the graph is still running.
+		switch (PrerequisiteNode->GetState())
+		{
+		case EAutomationGraphNodeState::Finished:
+			return EDependencyState::Ready;
+		case EAutomationGraphNodeState::Expired:
+		case EAutomationGraphNodeState::Cancelled:
+		case EAutomationGraphNodeState::Error:
+			return EDependencyState::Failed;
+		default:
+			return EDependencyState::Waiting;
+		}
+	}
+
+	if (IsGraphQueued(Prerequisite))
+	{
+		return EDependencyState::Waiting;
+	}
+
+	const bool* bLastRunSucceeded = LastRunResults.Find(Prerequisite);
+	if (!bLastRunSucceeded)
+	{
+		return EDependencyState::Ready;
+	}
+
+	if (PrerequisiteNode)
+	{
+		return PrerequisiteNode->GetState() == EAutomationGraphNodeState::Finished ? EDependencyState::Ready : EDependencyState::Failed;
+	}
+	
+	return *bLastRunSucceeded ? EDependencyState::Ready : EDependencyState::Failed;
+}
+
+UAutomationGraphExecutor* UAutomationGraphSubsystem::FindRunningExecutor(const UAutomationGraph* Graph) const
+{
+	for (UAutomationGraphExecutor* Executor : RunningExecutors)
+	{
+		if (Executor->GetTargetGraph() == Graph)
+		{
+			return Executor;
+		}
+	}
+
+	return nullptr;
+}
+
+bool UAutomationGraphSubsystem::IsGraphQueued(UAutomationGraph* Graph) const
+{
+	return TaskQueue.Contains(Graph);
+}
+
+bool UAutomationGraphSubsystem::HasDependencyCycle(const UAutomationGraph* Graph)
+{
+	TArray<const UAutomationGraph*> GraphStack;
+	TSet<const UAutomationGraph*> Visited;
+
+	GraphStack.Add(Graph);
+
+	while (!GraphStack.IsEmpty())
+	{
+		const UAutomationGraph* CurrentGraph = GraphStack.Pop();
+		for (const FAutomationGraphDependency& Dependency : CurrentGraph->Dependencies)
+		{
+			const UAutomationGraph* Prerequisite = Dependency.Graph.Get();
+			if (Prerequisite == Graph)
+			{
+				return true;
+			}
+
+			if (Prerequisite && !Visited.Contains(Prerequisite))
+			{
+				Visited.Add(Prerequisite);
+				GraphStack.Add(Prerequisite);
+			}
+		}
 	}
+
+	return false;
 }
 
 UWorld* UAutomationGraphSubsystem::GetWorld() const
@@ -138,31 +557,246 @@ UWorld* UAutomationGraphSubsystem::GetWorld() const
 	return nullptr;
 }
 
-void UAutomationGraphSubsystem::EnqueueAutomationGraph(UAutomationGraph* NewGraph, EAutomationGraphNodeTrigger EnqueueReason)
+FAutomationGraphRunHandle UAutomationGraphSubsystem::EnqueueAutomationGraph(UAutomationGraph* NewGraph, EAutomationGraphNodeTrigger EnqueueReason, EAutomationGraphTaskPriority Priority)
+{
+	TSharedPtr<FAutomationGraphRunState, ESPMode::ThreadSafe> RunState = MakeShared<FAutomationGraphRunState, ESPMode::ThreadSafe>();
+	EnqueueRun(NewGraph, EnqueueReason, Priority, RunState);
+	return FAutomationGraphRunHandle(RunState);
+}
+
+FAutomationGraphRunHandle UAutomationGraphSubsystem::SubmitAutomationGraph(const FSoftObjectPath& GraphPath, EAutomationGraphNodeTrigger EnqueueReason, EAutomationGraphTaskPriority Priority)
+{
+	TSharedPtr<FAutomationGraphRunState, ESPMode::ThreadSafe> RunState = MakeShared<FAutomationGraphRunState, ESPMode::ThreadSafe>();
+	Submissions.Enqueue(FGraphRunSubmission(GraphPath, EnqueueReason, Priority, RunState));
+	return FAutomationGraphRunHandle(RunState);
+}
+
+void UAutomationGraphSubsystem::DrainSubmissions()
+{
+	FGraphRunSubmission Submission;
+	while (Submissions.Dequeue(Submission))
+	{
+		auto* Graph = Cast<UAutomationGraph>(Submission.GraphPath.TryLoad());
+		if (!Graph)
+		{
+			UE_LOG(LogAutomationGraphSubsystem, Error, TEXT("Failed to load submitted graph %s."), *Submission.GraphPath.ToString());
+			Submission.RunState->Complete(false);
+			continue;
+		}
+
+		EnqueueRun(Graph, Submission.Trigger, Submission.Priority, Submission.RunState);
+	}
+}
+
+void UAutomationGraphSubsystem::EnqueueRun(UAutomationGraph* NewGraph, EAutomationGraphNodeTrigger EnqueueReason, EAutomationGraphTaskPriority Priority, const TSharedPtr<FAutomationGraphRunState, ESPMode::ThreadSafe>& RunState)
 {
 	if (!NewGraph)
 	{
+		RunState->Complete(false);
+		return;
+	}
+
+	if (HasDependencyCycle(NewGraph))
+	{
+		UE_LOG(LogAutomationGraphSubsystem, Error, TEXT("%s: The graph depends on itself. It will not be run."), *NewGraph->GetName());
+		RunState->Complete(false);
 		return;
 	}
 	
-	for (FGraphExecutionTask GraphTask : TaskQueue)
+	if (FQueuedGraphTask* QueuedTask = TaskQueue.Find(NewGraph))
 	{
-		if (GraphTask.TargetGraph.Get() == NewGraph)
+		// Upgrade a queued partial run to a full run. The queued run keeps its own trigger, so the roots for this trigger
+		// are started alongside it.
+		QueuedTask->Task.DirtyNodes.Empty();
+		QueuedTask->Task.MergeTrigger(EnqueueReason);
+		QueuedTask->Priority = FMath::Max(QueuedTask->Priority, Priority);
+		QueuedTask->RunStates.Add(RunState);
+		return;
+	}
+	
+	FQueuedGraphTask& NewTask = AddTask(FGraphExecutionTask(NewGraph, nullptr, EnqueueReason), Priority);
+	NewTask.RunStates.Add(RunState);
+}
+
+void UAutomationGraphSubsystem::EnqueueDirtySubgraph(UAutomationGraph* Graph, const TArray<UAutomationGraphNode*>& DirtyNodes)
+{
+	if (!Graph || DirtyNodes.IsEmpty())
+	{
+		return;
+	}
+
+	if (HasDependencyCycle(Graph))
+	{
+		UE_LOG(LogAutomationGraphSubsystem, Error, TEXT("%s: The graph depends on itself. It will not be run."), *Graph->GetName());
+		return;
+	}
+
+	if (FQueuedGraphTask* QueuedTask = TaskQueue.Find(Graph))
+	{
+		// A queued full run already covers these nodes. Otherwise, fold them into the queued partial run.
+		if (!QueuedTask->Task.DirtyNodes.IsEmpty())
 		{
-			return;
+			for (UAutomationGraphNode* DirtyNode : DirtyNodes)
+			{
+				QueuedTask->Task.DirtyNodes.AddUnique(DirtyNode);
+			}
 		}
+		QueuedTask->Priority = EAutomationGraphTaskPriority::Interactive;
+		return;
 	}
-	TaskQueue.Add(FGraphExecutionTask(NewGraph, nullptr, EnqueueReason));	
+
+	FQueuedGraphTask& NewTask = AddTask(FGraphExecutionTask(Graph, nullptr, EAutomationGraphNodeTrigger::OnPlay), EAutomationGraphTaskPriority::Interactive);
+	NewTask.Task.DirtyNodes.Append(DirtyNodes);
 }
 
-void UAutomationGraphSubsystem::CancelGraphExecution(UAutomationGraph* Graph)
+UAutomationGraphSubsystem::FQueuedGraphTask& UAutomationGraphSubsystem::AddTask(const FGraphExecutionTask& ExecutionTask, EAutomationGraphTaskPriority Priority)
+{
+	FQueuedGraphTask& QueuedTask = TaskQueue.Add(ExecutionTask.TargetGraph);
+	QueuedTask.Task = ExecutionTask;
+	QueuedTask.Priority = Priority;
+	QueuedTask.Sequence = NextTaskSequence++;
+	return QueuedTask;
+}
+
+void UAutomationGraphSubsystem::CompleteTask(FQueuedGraphTask& QueuedTask, bool bSucceeded)
 {
-	if (!CurrentExecutor)
+	for (const TSharedPtr<FAutomationGraphRunState, ESPMode::ThreadSafe>& RunState : QueuedTask.RunStates)
+	{
+		RunState->Complete(bSucceeded);
+	}
+	QueuedTask.RunStates.Empty();
+}
+
+void UAutomationGraphSubsystem::ClearTaskQueue()
+{
+	for (TPair<TWeakObjectPtr<UAutomationGraph>, FQueuedGraphTask>& QueuedTask : TaskQueue)
+	{
+		CompleteTask(QueuedTask.Value, false);
+	}
+	TaskQueue.Empty();
+}
+
+void UAutomationGraphSubsystem::SetWatchEnabled(UAutomationGraph* Graph, bool bEnabled)
+{
+	if (!Graph)
 	{
 		return;
 	}
 
-	CurrentExecutor->Cancel(Graph);
+	if (bEnabled)
+	{
+		WatchedGraphs.Add(Graph);
+	}
+	else
+	{
+		WatchedGraphs.Remove(Graph);
+		PendingWatchChanges.Remove(Graph);
+	}
+}
+
+bool UAutomationGraphSubsystem::IsWatchEnabled(UAutomationGraph* Graph) const
+{
+	return Graph && WatchedGraphs.Contains(Graph);
+}
+
+void UAutomationGraphSubsystem::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	if (bIsTestWorker)
+	{
+		return;
+	}
+
+	if (auto* FileTrigger = Cast<UAGN_TriggerOnFileChange>(Object))
+	{
+		FileWatcher.WatchGraph(FileTrigger->GetTypedOuter<UAutomationGraph>());
+	}
+	else if (auto* AssetTrigger = Cast<UAGN_TriggerOnAssetChange>(Object))
+	{
+		AssetWatcher.WatchGraph(AssetTrigger->GetTypedOuter<UAutomationGraph>());
+	}
+	else if (auto* ScheduleTrigger = Cast<UAGN_TriggerOnSchedule>(Object))
+	{
+		Scheduler.WatchGraph(ScheduleTrigger->GetTypedOuter<UAutomationGraph>());
+	}
+	
+	auto* Node = Cast<UAutomationGraphNode>(Object);
+	if (!Node || WatchedGraphs.IsEmpty())
+	{
+		return;
+	}
+
+	auto* Graph = Node->GetTypedOuter<UAutomationGraph>();
+	if (!Graph || !WatchedGraphs.Contains(Graph))
+	{
+		return;
+	}
+
+	PendingWatchChanges.FindOrAdd(Graph).Add(Node);
+	WatchDebounceTimer = WatchDebounceSec;
+}
+
+void UAutomationGraphSubsystem::OnObjectPreSave(UObject* Object, FObjectPreSaveContext SaveContext)
+{
+	// The editor graph isn't saved with the asset, so its layout has to be copied onto the graph first.
+	auto* Graph = Cast<UAutomationGraph>(Object);
+	if (Graph && Graph->EditorGraph)
+	{
+		CastChecked<UEdGraph_AutomationGraph>(Graph->EditorGraph)->StoreNodePositions();
+	}
+}
+
+void UAutomationGraphSubsystem::OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	// Trigger nodes may have been added or removed since the graph was loaded.
+	if (bIsTestWorker)
+	{
+		return;
+	}
+
+	ForEachObjectWithPackage(Package, [this](UObject* Object)
+	{
+		if (auto* Graph = Cast<UAutomationGraph>(Object))
+		{
+			FileWatcher.WatchGraph(Graph);
+			AssetWatcher.WatchGraph(Graph);
+			Scheduler.WatchGraph(Graph);
+		}
+		return true;
+	}, false);
+}
+
+void UAutomationGraphSubsystem::FlushWatchChanges()
+{
+	for (const TPair<TWeakObjectPtr<UAutomationGraph>, TSet<TWeakObjectPtr<UAutomationGraphNode>>>& Change : PendingWatchChanges)
+	{
+		UAutomationGraph* Graph = Change.Key.Get();
+		if (!Graph)
+		{
+			continue;
+		}
+
+		TArray<UAutomationGraphNode*> DirtyNodes;
+		for (TWeakObjectPtr<UAutomationGraphNode> WeakNode : Change.Value)
+		{
+			if (UAutomationGraphNode* Node = WeakNode.Get())
+			{
+				DirtyNodes.Add(Node);
+			}
+		}
+
+		UE_LOG(LogAutomationGraphSubsystem, Log, TEXT("%s: %d node(s) changed. Re-running the affected subgraph."), *Graph->GetName(), DirtyNodes.Num());
+		EnqueueDirtySubgraph(Graph, DirtyNodes);
+	}
+	
+	PendingWatchChanges.Empty();
+}
+
+void UAutomationGraphSubsystem::CancelGraphExecution(UAutomationGraph* Graph)
+{
+	if (UAutomationGraphExecutor* Executor = FindRunningExecutor(Graph))
+	{
+		Executor->Cancel(Graph);
+	}
 }
 
 TArray<FAutomationGraphNodeInfo> UAutomationGraphSubsystem::GetSupportedNodes(UAutomationGraph* Graph)
@@ -213,25 +847,56 @@ bool UAutomationGraphSubsystem::ReleaseAutomationController(UAutomationGraphNode
 	return true;
 }
 
-void UAutomationGraphSubsystem::StartExecution(FGraphExecutionTask& ExecutionTask)
+bool UAutomationGraphSubsystem::StartExecution(FQueuedGraphTask& QueuedTask)
 {
+	FGraphExecutionTask& ExecutionTask = QueuedTask.Task;
 	UAutomationGraph* Graph = ExecutionTask.TargetGraph.Get();
 	
 	TSubclassOf<UAutomationGraphExecutor> ExecutorType = Graph->GetExecutorType();
-	TObjectPtr<UAutomationGraphExecutor>* FindResult = Executors.Find(ExecutorType);
-	
-	if (FindResult)
+
+	// Prefer the executor that last ran this graph, then one whose graph has been unloaded.
+	int32 ExecutorIndex = IdleExecutors.IndexOfByPredicate([Graph, ExecutorType](const UAutomationGraphExecutor* Executor)
+	{
+		return Executor->GetClass() == ExecutorType && Executor->GetTargetGraph() == Graph;
+	});
+	if (ExecutorIndex == INDEX_NONE)
 	{
-		CurrentExecutor = *FindResult;
+		ExecutorIndex = IdleExecutors.IndexOfByPredicate([ExecutorType](const UAutomationGraphExecutor* Executor)
+		{
+			return Executor->GetClass() == ExecutorType && !Executor->GetTargetGraph();
+		});
+	}
+
+	UAutomationGraphExecutor* Executor = nullptr;
+	if (ExecutorIndex != INDEX_NONE)
+	{
+		Executor = IdleExecutors[ExecutorIndex];
+		IdleExecutors.RemoveAtSwap(ExecutorIndex);
 	}
 	else
 	{
-		CurrentExecutor = NewObject<UAutomationGraphExecutor>(this, ExecutorType);
-		Executors.Add(ExecutorType, CurrentExecutor);
+		Executor = NewObject<UAutomationGraphExecutor>(this, ExecutorType);
 	}
 
 	ExecutionTask.TargetWorld = GetWorld();
-	CurrentExecutor->StartExecution(ExecutionTask);
+	Executor->StartExecution(ExecutionTask);
+
+	// Runs that fail to start, or have nothing to do, end right away.
+	if (!Executor->IsRunning())
+	{
+		LastRunResults.Add(Graph, Executor->DidLastRunSucceed());
+		CompleteTask(QueuedTask, Executor->DidLastRunSucceed());
+		IdleExecutors.Add(Executor);
+		return false;
+	}
+
+	for (const TSharedPtr<FAutomationGraphRunState, ESPMode::ThreadSafe>& RunState : QueuedTask.RunStates)
+	{
+		RunState->SetRunning();
+	}
+	RunningExecutors.Add(Executor);
+	RunningTasks.Add(Graph, QueuedTask);
+	return true;
 }
 
 void UAutomationGraphSubsystem::EnqueueStartupGraphs()
@@ -255,16 +920,25 @@ void UAutomationGraphSubsystem::EnqueueStartupGraphs()
 		if (!GraphAsset)
 		{
 			UE_LOG(LogAutomationGraphSubsystem, Error, TEXT("Invalid graph asset"));
+			continue;
 		}
 
-		bool bContinueSearch = true;
-		for (int NodeIndex = 0; NodeIndex < GraphAsset->RootNodes.Num() && bContinueSearch; ++NodeIndex)
+		if (GraphAsset->HasRootTrigger(EAutomationGraphNodeTrigger::OnFileChange))
 		{
-			if (GraphAsset->RootNodes[NodeIndex]->GetTriggers().Contains(EAutomationGraphNodeTrigger::OnStartup))
-			{
-				GraphsToEnqueue.Add(GraphAsset);
-				bContinueSearch = false;
-			}
+			FileWatcher.WatchGraph(GraphAsset);
+		}
+		if (GraphAsset->HasRootTrigger(EAutomationGraphNodeTrigger::OnAssetChange))
+		{
+			AssetWatcher.WatchGraph(GraphAsset);
+		}
+		if (GraphAsset->HasRootTrigger(EAutomationGraphNodeTrigger::OnSchedule))
+		{
+			Scheduler.WatchGraph(GraphAsset);
+		}
+
+		if (GraphAsset->HasRootTrigger(EAutomationGraphNodeTrigger::OnStartup))
+		{
+			GraphsToEnqueue.Add(GraphAsset);
 		}
 	}
 
@@ -51,4 +51,6 @@ private:
 	
 	TSharedPtr<FAutomationGraphNodeFactory> AGNodeFactory;
 	TArray< TSharedPtr<IAssetTypeActions> > CreatedAssetTypeActions;
+	FDelegateHandle EngineLoopInitCompleteHandle;
+	FDelegateHandle GraphRebuildingHandle;
 };
\ No newline at end of file
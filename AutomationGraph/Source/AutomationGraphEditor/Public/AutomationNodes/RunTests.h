@@ -33,9 +33,14 @@
 #include "AutomationGraphRuntimeConstants.h"
 #include "IAutomationControllerManager.h"
 #include "Foundation/AutomationGraphNode.h"
+#include "Foundation/AutomationGraphTestResultsWriter.h"
+#include "HAL/PlatformProcess.h"
 
 #include "RunTests.generated.h"
 
+struct FAutomatedTestFilter;
+struct FAutomationGraphTestHistory;
+
 UCLASS(meta=( DisplayName="Run Tests" ))
 class AUTOMATIONGRAPHEDITOR_API UAGN_RunTests : public UCoreAutomationGraphNode
 {
@@ -47,9 +52,20 @@ class AUTOMATIONGRAPHEDITOR_API UAGN_RunTests : public UCoreAutomationGraphNode
 		WaitForController,
 		WaitForTestsReady,
 		RunningTests,
+		RunningShards,
 		Complete
 	};
 
+	// A slice of the requested tests, run by a headless editor process on this machine.
+	struct FTestShard
+	{
+		TArray<FString> Tests;
+		float ExpectedDurationSec = 0.0f;
+		FString ReportDirectory;
+		FProcHandle Process;
+		bool bMerged = false;
+	};
+
 public:
 	UAGN_RunTests(const FObjectInitializer& Initializer);
 	
@@ -57,27 +73,156 @@ public:
 	virtual FText GetNodeCategory() override { return FAutomationGraphNodeCategory::TestAutomation; }
 	virtual bool Initialize(UWorld* World) override;
 	virtual void Cleanup() override;
+	virtual void GetInputSlots(TArray<FAutomationGraphDataSlot>& OutSlots) override;
+	virtual void GetOutputSlots(TArray<FAutomationGraphDataSlot>& OutSlots) override;
+	virtual FString GetMessageText() override;
 	//~End UAutomationGraphNode interface.
 
+	//~UObject interface.
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	//~End UObject interface.
+
+	// Optional input. Any test names (or filters) passed in from upstream are run in addition to Tests.
+	static const FName TestsInputName;
+
+	// Full paths of the tests that failed.
+	static const FName FailedTestsOutputName;
+
+	// On a test worker launched by a Run Tests node, queues the tests the node assigned to it. Does nothing in any other
+	// editor. Called by the editor module once the engine has finished starting up.
+	static void QueueWorkerTests();
+
+	// Whether this editor is a test worker launched by a Run Tests node.
+	static bool IsTestWorker();
+
+	// Unbinds the delegates that track changes to the set of registered tests. Called by the editor module on shutdown.
+	static void StopTrackingTestListChanges();
+
 	virtual void TestsReady();
 
+	// Called when the controller's test availability changes, which happens once a worker has answered and sent its
+	// test list.
+	virtual void WorkersReady(EAutomationControllerModuleState::Type ControllerState);
+
 	// These match to names defined in FAutomationTestBase::GetBeautifiedTestName()
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TArray<FString> Tests;
 
+	// If greater than zero, the tests are split across this many headless editor processes on this machine instead of
+	// running on the workers found by the automation controller. Shards are balanced using each test's duration on
+	// previous runs.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0"))
+	int32 NumLocalWorkers = 0;
+
+	// Extra command line arguments passed to each local worker.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString WorkerCommandLine;
+
+	// Only run tests whose source module, the project and plugin modules it depends on, or assets have changed since
+	// they last passed. Tests that have never passed, or whose dependencies can't be determined, always run.
+	//
+	// WARNING: This can skip tests that are affected by a change. Module dependencies are read from .Build.cs files, so
+	// code reached without a module dependency (reflection, config, interfaces implemented in another module) isn't
+	// tracked, and neither are changes to engine source beyond the engine version. Use it for fast iteration, not as
+	// the only test run before submitting.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bOnlyImpactedTests = false;
+
+	// Run tests that failed last time, or that often change result, in a batch before the rest. Only applies when
+	// running through the automation controller, local workers run their tests in their own order.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bRunLikelyFailuresFirst = false;
+
+	// If greater than zero, stop testing and put the node into the Error state as soon as this many tests have failed.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0"))
+	int32 FailFastThreshold = 0;
+
+	// Where Results.xml (JUnit) and Results.jsonl are written as tests complete. Defaults to
+	// Saved/AutomationGraph/TestResults/<NodeName>.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString ResultsDirectory;
+
 protected:
 	//~UAutomationGraphNode interface.
 	virtual EAutomationGraphNodeState ActivateInternal(float DeltaSeconds) override;
 	//~End UAutomationGraphNode interface.
 
+	void BindControllerEvents();
+	void UnbindControllerEvents();
+
+	// Asks the controller to look for workers, unless one has already answered and is still sending its tests.
+	void RequestWorkers();
+	FString DescribeMissingWorkers() const;
+
 	void GenerateTestNames(TSharedPtr <AutomationFilterCollection> InFilters, TArray<FString>& OutFilteredTestNames);
+	void GenerateTestFilters(TArray<FAutomatedTestFilter>& OutFilters);
+
+	// Hashes RequestedTests, the automation group settings, and a description of the test list they are resolved
+	// against. Resolved test names are reused for as long as this key doesn't change.
+	FString MakeResolvedTestsKey(const FString& TestListVersion) const;
+	// Adds the current batch's failures to FailedTestsOutputName and records the results in the test history.
+	void WriteFailedTests();
+	int32 CountFailedReports() const;
+
+	void OpenResults();
+
+	// Writes any tests in the current batch that have finished since the last call.
+	void StreamCompletedReports();
+
+	// Called when a batch ends or is stopped. Writes the batch's finished tests, and the rest as skipped with Reason.
+	void FlushBatchReports(const FString& Reason);
+	void WriteSkippedTests(const TArray<FString>& TestNames, const FString& Reason);
+
+	// Splits the tests into the batches that are handed to the controller one after another. See bRunLikelyFailuresFirst.
+	void BuildTestBatches(const TArray<FString>& TestNames);
+	void StartNextTestBatch();
+	bool ShouldFailFast(int32 NumFailures) const;
+
+	// Resolves RequestedTests against the tests registered in this process, without going through a controller.
+	void GenerateLocalTestNames(TArray<FString>& OutTestNames);
 	
-	float FindWorkersTimeoutSec = 10.0f;
-	int32 MaxFindWorkersAttempts = 6;
+	// Greedy longest-test-first partition, each test goes to whichever shard currently has the least expected work.
+	void BuildShards(const TArray<FString>& TestNames);
+	bool LaunchShard(FTestShard& Shard, int32 ShardIndex);
+	void TerminateShards();
+
+	// Removes tests that passed last time against the same dependencies, and reports them as skipped. See
+	// bOnlyImpactedTests.
+	void SelectImpactedTests(TArray<FString>& InOutTestNames);
+	void RecordTestDependencies(FAutomationGraphTestHistory& TestHistory, const FString& TestPath, bool bPassed) const;
+
+	// Reads a finished shard's report and adds its failures to FailedTestsOutputName.
+	void MergeShardResult(FTestShard& Shard, int32 ShardIndex);
+	
+	// Worker requests are retried with exponential backoff until a worker answers or FindWorkersTimeoutSec passes.
+	float FindWorkersInitialBackoffSec = 0.25f;
+	float FindWorkersMaxBackoffSec = 4.0f;
+	float FindWorkersTimeoutSec = 30.0f;
 
 	ETestState TestState = ETestState::Idle;
-	float FindWorkersTimerSec = 0.0f;
-	int32 FindWorkersAttemtps = 0;
+	float FindWorkersElapsedSec = 0.0f;
+	float FindWorkersRetrySec = 0.0f;
+	float FindWorkersBackoffSec = 0.0f;
+	int32 FindWorkersRequests = 0;
+
+	// Tests plus any tests passed in from upstream.
+	TArray<FString> RequestedTests;
+
+	TArray<FTestShard> Shards;
+
+	TArray<TArray<FString>> TestBatches;
+	int32 NextTestBatch = 0;
+	int32 NumFailedTests = 0;
+
+	FAutomationGraphTestResultsWriter ResultsWriter;
+	TSet<FString> StreamedTests;
+
+	// Result of the last filter pass, see MakeResolvedTestsKey().
+	FString ResolvedTestsKey;
+	TArray<FString> ResolvedTestNames;
+
+	// Dependency hashes of the tests selected for this run, recorded for the ones that pass.
+	TMap<FString, FString> TestDependencyHashes;
 
 	FGuid SessionID;
 	IAutomationControllerManagerPtr AutomationController;
@@ -141,4 +141,17 @@ class UEdGraph_AutomationGraph : public UEdGraph
 public:
 	UAutomationGraph* GetAutomationGraph();
 	void RebuildAutomationGraph();
+
+	// The inverse of RebuildAutomationGraph(). Creates an editor node for every runtime node and an edge node for every
+	// parent/child link. Used for graphs that were built in code (see FAutomationGraphBuilder) and have no editor graph.
+	void RebuildEditorGraph();
+
+	// Copies the position of every editor node into UAutomationGraph::EditorNodePositions. The editor graph itself is
+	// transient, so this is what RebuildEditorGraph() lays the nodes out from the next time the asset is opened.
+	void StoreNodePositions();
+
+	//~UObject interface
+	// The editor graph (and every editor node and edge it owns) is never needed to execute the graph.
+	virtual bool IsEditorOnly() const override { return true; }
+	//~End UObject interface
 };
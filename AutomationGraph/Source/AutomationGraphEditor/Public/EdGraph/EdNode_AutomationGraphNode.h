@@ -76,6 +76,8 @@ public:
 	virtual void AllocateDefaultPins() override;
 	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
 	virtual void PrepareForCopying() override;
+	virtual void PostCopyNode() override;
+	virtual void PostPasteNode() override;
 	virtual void AutowireNewNode(UEdGraphPin* FromPin) override;
 	//~End UEdGraphNode interface
 
@@ -84,4 +86,8 @@ public:
 	virtual UEdGraphPin* GetOutputPin() const;
 
 	virtual const FSlateBrush* GetNodeIcon();
+
+	// Moves AutomationNode back under the automation graph. Automation nodes are only outered to their editor node
+	// while they are being copied; the editor graph is transient, so anything left inside it would be lost on save.
+	void ResetAutomationNodeOwner();
 };
\ No newline at end of file
@@ -48,6 +48,8 @@ public:
 
 	TSharedPtr<FUICommandInfo> ExecuteGraph;
 	TSharedPtr<FUICommandInfo> CancelExecution;
+	TSharedPtr<FUICommandInfo> ExecuteSelectedNodes;
+	TSharedPtr<FUICommandInfo> ToggleWatch;
 
 // boilerplate
 public:
@@ -147,4 +149,10 @@ protected:
 
 	bool CanCancelExecution() const;
 	void CancelExecution();
+
+	bool CanExecuteSelectedNodes() const;
+	void ExecuteSelectedNodes();
+
+	bool IsWatchEnabled() const;
+	void ToggleWatch();
 };
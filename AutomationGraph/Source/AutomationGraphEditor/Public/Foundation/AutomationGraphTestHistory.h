@@ -0,0 +1,133 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "CoreMinimal.h"
+
+#include "AutomationGraphTestHistory.generated.h"
+
+USTRUCT()
+struct AUTOMATIONGRAPHEDITOR_API FAutomationGraphTestRecord
+{
+	GENERATED_BODY()
+
+public:
+	// Moving average, weighted toward recent runs.
+	UPROPERTY()
+	float AverageDurationSec = 0.0f;
+
+	// Runs that reported a duration.
+	UPROPERTY()
+	int32 NumTimedRuns = 0;
+
+	UPROPERTY()
+	int32 NumRuns = 0;
+
+	UPROPERTY()
+	int32 NumFailures = 0;
+
+	// Number of times the result went from pass to fail or back, a rough measure of flakiness.
+	UPROPERTY()
+	int32 NumResultChanges = 0;
+
+	UPROPERTY()
+	bool bFailedLastRun = false;
+
+	// Dependency hash from the last time the test passed, see FAutomationGraphTestImpact. Cleared when the test fails.
+	UPROPERTY()
+	FString PassedDependencyHash;
+};
+
+USTRUCT()
+struct AUTOMATIONGRAPHEDITOR_API FAutomationGraphTestHistoryData
+{
+	GENERATED_BODY()
+
+public:
+	// Full test path -> record.
+	UPROPERTY()
+	TMap<FString, FAutomationGraphTestRecord> Tests;
+};
+
+// Per-test statistics shared by every Run Tests node in the project, stored in Saved/AutomationGraph/TestHistory.json.
+// Used to balance test shards across workers, to run likely failures first, and to skip tests whose dependencies haven't
+// changed since they last passed.
+//
+// Several nodes (or editors) can have the history loaded at once, so Save() doesn't write back the copy that was loaded.
+// It reloads the file and replays the results recorded since Load() on top of it.
+struct AUTOMATIONGRAPHEDITOR_API FAutomationGraphTestHistory
+{
+	static FString GetHistoryFilePath();
+
+	// A missing history file is not an error, the history just starts out empty.
+	void Load();
+
+	// Merges the results recorded since the history was loaded into the file on disk, if there are any.
+	bool Save();
+
+	// Pass a negative DurationSec if the duration is unknown, e.g. because the worker crashed.
+	void RecordResult(const FString& TestPath, float DurationSec, bool bPassed);
+	void RecordDependencies(const FString& TestPath, const FString& DependencyHash, bool bPassed);
+	const FAutomationGraphTestRecord* FindRecord(const FString& TestPath) const { return Data.Tests.Find(TestPath); }
+
+	// True if the test passed the last time it ran against these dependencies.
+	bool PassedWithDependencies(const FString& TestPath, const FString& DependencyHash) const;
+
+	// Zero for tests that passed last time and have never changed result. Tests that failed last time score at least
+	// one, with flaky tests scoring higher.
+	float GetFailureScore(const FString& TestPath) const;
+
+	// Expected duration of the test. Tests that have never run are assumed to take as long as the average test, as of the
+	// last Load() or Save().
+	float GetExpectedDuration(const FString& TestPath) const;
+
+private:
+	struct FPendingResult
+	{
+		FString TestPath;
+		float DurationSec = -1.0f;
+		bool bPassed = false;
+
+		// Set for RecordDependencies().
+		bool bDependenciesOnly = false;
+		FString DependencyHash;
+	};
+
+	static bool LoadData(FAutomationGraphTestHistoryData& OutData);
+	static void ApplyResult(FAutomationGraphTestHistoryData& InOutData, const FPendingResult& Result);
+	void UpdateAverageDuration();
+	
+	FAutomationGraphTestHistoryData Data;
+	TArray<FPendingResult> PendingResults;
+
+	// Average over every timed test, computed once per load rather than for each test that has never run.
+	float AverageDurationSec = 0.0f;
+};
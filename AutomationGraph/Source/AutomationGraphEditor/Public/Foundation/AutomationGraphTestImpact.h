@@ -0,0 +1,78 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "CoreMinimal.h"
+
+struct FAutomationGraphCacheInputs;
+class FAutomationTestInfo;
+
+// Fingerprints what an automation test depends on, so that a test can be skipped if none of it has changed since the
+// test last passed. A test depends on:
+// - Every file in the source module that declares it, and in every project or plugin module that module depends on,
+//   directly or not. Dependencies are read from the modules' .Build.cs files.
+// - The engine version. Engine modules themselves aren't fingerprinted.
+// - The asset it tests (if any), along with everything that asset references.
+//
+// Module and package fingerprints are cached for the lifetime of the object, so use one instance per test run.
+class AUTOMATIONGRAPHEDITOR_API FAutomationGraphTestImpact
+{
+public:
+	// Returns an empty string if the test's dependencies can't be determined, e.g. because an asset it depends on has
+	// unsaved changes. Such tests should always run.
+	FString GetDependencyHash(const FAutomationTestInfo& TestInfo);
+
+private:
+	// The .Build.cs file of the module containing SourceFile. Empty if there isn't one.
+	FString FindModuleRulesFile(const FString& SourceFile);
+	const FString& GetModuleHash(const FString& ModuleDirectory);
+
+	// Rules files of the given module and of every project or plugin module it depends on, sorted.
+	const TArray<FString>& GetModuleClosure(const FString& RulesFile);
+
+	// Module names referenced by a .Build.cs file. Any string literal that names a project or plugin module counts, which
+	// can only ever add dependencies.
+	TArray<FString> GetReferencedModules(const FString& RulesFile);
+	void DiscoverProjectModules();
+
+	// Adds the saved hash of PackageName and all of its package dependencies.
+	void AddPackageDependencies(FName PackageName, FAutomationGraphCacheInputs& Inputs);
+	FName GetTestPackageName(const FAutomationTestInfo& TestInfo) const;
+
+	TMap<FString, FString> SourceDirectoryToModule;
+	TMap<FString, FString> ModuleHashes;
+	TMap<FString, TArray<FString>> ModuleClosures;
+
+	// Module name -> .Build.cs file, for every module in the project and its plugins.
+	TMap<FString, FString> ProjectModuleRulesFiles;
+	bool bDiscoveredProjectModules = false;
+	TMap<FName, TArray<FName>> PackageDependencies;
+};
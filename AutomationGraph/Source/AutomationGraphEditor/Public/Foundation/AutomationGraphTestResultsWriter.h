@@ -0,0 +1,68 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+
+// Writes test results to disk as they come in, so that they can be read while a run is still going.
+//
+// Results.xml is a JUnit report, kept valid after every result by rewriting the closing tags and the test counts on the
+// <testsuite> element. Results.jsonl has one JSON object per line, for tools that want to tail the file.
+class AUTOMATIONGRAPHEDITOR_API FAutomationGraphTestResultsWriter
+{
+public:
+	~FAutomationGraphTestResultsWriter() { Close(); }
+	
+	// Starts new reports in Directory, replacing any from a previous run.
+	bool Open(const FString& Directory, const FString& SuiteName);
+	void Close();
+	bool IsOpen() const { return JUnitFile.IsValid(); }
+
+	void AddResult(const FString& TestPath, bool bPassed, float DurationSec, const TArray<FString>& Errors);
+
+	// For tests that were selected but never ran to completion, e.g. because the run stopped early.
+	void AddSkipped(const FString& TestPath, const FString& Reason);
+
+private:
+	void WriteTestCase(const FString& TestPath, const FString& State, float DurationSec, const FString& Body, const TArray<FString>& Errors, const FString& Reason);
+	void WriteCounts();
+	static void WriteUTF8(IFileHandle& File, const FString& Text);
+
+	TUniquePtr<IFileHandle> JUnitFile;
+	TUniquePtr<IFileHandle> JsonFile;
+
+	// Offset of the count attributes in Results.xml. They are padded to a fixed width so they can be rewritten in place.
+	int64 CountsOffset = 0;
+	int32 NumTests = 0;
+	int32 NumFailures = 0;
+	int32 NumSkipped = 0;
+};
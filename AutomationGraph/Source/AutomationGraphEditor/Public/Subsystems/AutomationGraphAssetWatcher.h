@@ -0,0 +1,69 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "AutomationGraphChangeBatches.h"
+
+class FObjectPostSaveContext;
+class UAGN_TriggerOnAssetChange;
+class UAutomationGraph;
+class UFactory;
+
+// Listens for asset saves, imports, and reimports, and collects the matching assets for each asset trigger node
+// (UAGN_TriggerOnAssetChange) of the watched graphs into a batch until its debounce window has passed.
+class AUTOMATIONGRAPHEDITOR_API FAutomationGraphAssetWatcher
+{
+public:
+	~FAutomationGraphAssetWatcher();
+
+	void Start();
+	void Stop();
+
+	// Replaces the graph's tracked trigger nodes with its current asset trigger nodes.
+	void WatchGraph(UAutomationGraph* Graph);
+	void UnwatchGraph(UAutomationGraph* Graph);
+
+	// Hands every batch whose debounce window has passed to its node, and returns the graphs that should run.
+	TArray<UAutomationGraph*> FlushChanges(double CurrentTime);
+
+private:
+	void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+	void OnAssetPostImport(UFactory* Factory, UObject* Asset);
+	void OnAssetReimport(UObject* Asset);
+	void AddChangedAsset(UObject* Asset, bool bImported);
+
+	TMap<TWeakObjectPtr<UAutomationGraph>, TArray<TWeakObjectPtr<UAGN_TriggerOnAssetChange>>> TriggerNodes;
+	TAutomationGraphChangeBatches<UAGN_TriggerOnAssetChange, FSoftObjectPath> PendingChanges;
+
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle AssetPostImportHandle;
+	FDelegateHandle AssetReimportHandle;
+};
@@ -0,0 +1,91 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+class UAutomationGraph;
+
+// Collects changes (files, assets) for each change trigger node into a batch until the node's DebounceSec has passed
+// since its last change. Shared by FAutomationGraphFileWatcher and FAutomationGraphAssetWatcher.
+template <typename NodeType, typename ItemType>
+class TAutomationGraphChangeBatches
+{
+public:
+	void AddChange(NodeType* TriggerNode, UAutomationGraph* Graph, ItemType Item, double CurrentTime)
+	{
+		FChangeBatch& Batch = PendingChanges.FindOrAdd(TriggerNode);
+		Batch.Graph = Graph;
+		Batch.Items.AddUnique(MoveTemp(Item));
+		Batch.LastChangeTime = CurrentTime;
+	}
+
+	void Remove(TWeakObjectPtr<NodeType> TriggerNode) { PendingChanges.Remove(TriggerNode); }
+	void Reset() { PendingChanges.Empty(); }
+
+	// Hands every batch whose debounce window has passed to DeliverBatch, and returns the graphs they belong to. Batches
+	// whose node or graph has been destroyed are dropped.
+	TArray<UAutomationGraph*> Flush(double CurrentTime, TFunctionRef<void(UAutomationGraph*, NodeType*, const TArray<ItemType>&)> DeliverBatch)
+	{
+		TArray<UAutomationGraph*> TriggeredGraphs;
+
+		for (auto BatchIterator = PendingChanges.CreateIterator(); BatchIterator; ++BatchIterator)
+		{
+			NodeType* TriggerNode = BatchIterator.Key().Get();
+			UAutomationGraph* Graph = BatchIterator.Value().Graph.Get();
+			if (!TriggerNode || !Graph)
+			{
+				BatchIterator.RemoveCurrent();
+				continue;
+			}
+
+			if (CurrentTime - BatchIterator.Value().LastChangeTime < TriggerNode->DebounceSec)
+			{
+				continue;
+			}
+
+			DeliverBatch(Graph, TriggerNode, BatchIterator.Value().Items);
+			TriggeredGraphs.AddUnique(Graph);
+			BatchIterator.RemoveCurrent();
+		}
+
+		return TriggeredGraphs;
+	}
+
+private:
+	struct FChangeBatch
+	{
+		TWeakObjectPtr<UAutomationGraph> Graph;
+		TArray<ItemType> Items;
+		double LastChangeTime = 0.0;
+	};
+
+	TMap<TWeakObjectPtr<NodeType>, FChangeBatch> PendingChanges;
+};
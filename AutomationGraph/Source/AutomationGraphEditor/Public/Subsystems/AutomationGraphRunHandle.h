@@ -0,0 +1,80 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "HAL/Event.h"
+#include <atomic>
+
+enum class EAutomationGraphRunStatus : uint8
+{
+	// Submitted or queued, but not started yet. Also the state of a run that is waiting on its dependencies.
+	Pending,
+	Running,
+	Succeeded,
+
+	// The run failed, was cancelled, or was skipped because it could not start.
+	Failed
+};
+
+// Shared between the subsystem and every handle to a run. Several submissions of the same graph that are merged into
+// one queued run share its outcome.
+class AUTOMATIONGRAPHEDITOR_API FAutomationGraphRunState
+{
+public:
+	EAutomationGraphRunStatus GetStatus() const { return Status.load(); }
+	void SetRunning();
+	void Complete(bool bSucceeded);
+	bool Wait(FTimespan Timeout) const;
+
+private:
+	std::atomic<EAutomationGraphRunStatus> Status = EAutomationGraphRunStatus::Pending;
+	FEventRef CompletedEvent{EEventMode::ManualReset};
+};
+
+// Tracks a run submitted to UAutomationGraphSubsystem. Handles are cheap to copy and safe to use from any thread.
+class AUTOMATIONGRAPHEDITOR_API FAutomationGraphRunHandle
+{
+public:
+	FAutomationGraphRunHandle() = default;
+	explicit FAutomationGraphRunHandle(const TSharedPtr<FAutomationGraphRunState, ESPMode::ThreadSafe>& InState): State(InState) {}
+
+	bool IsValid() const { return State.IsValid(); }
+	EAutomationGraphRunStatus GetStatus() const;
+	bool IsComplete() const;
+	bool Succeeded() const { return GetStatus() == EAutomationGraphRunStatus::Succeeded; }
+
+	// Blocks until the run completes or the timeout elapses, and returns true if it completed. Graphs run on the game
+	// thread, so this must not be called from there.
+	bool Wait(FTimespan Timeout = FTimespan::MaxValue()) const;
+
+private:
+	TSharedPtr<FAutomationGraphRunState, ESPMode::ThreadSafe> State;
+};
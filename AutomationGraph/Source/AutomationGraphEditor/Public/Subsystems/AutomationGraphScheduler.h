@@ -0,0 +1,69 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+class UAGN_TriggerOnSchedule;
+class UAutomationGraph;
+
+// Keeps the next run time of every schedule trigger node (UAGN_TriggerOnSchedule) of the watched graphs in a single
+// min-heap. Each tick only compares the clock against the earliest deadline, so schedules cost nothing until one is due.
+class AUTOMATIONGRAPHEDITOR_API FAutomationGraphScheduler
+{
+public:
+	// Replaces the graph's schedules with ones for its current schedule trigger nodes.
+	void WatchGraph(UAutomationGraph* Graph);
+	void UnwatchGraph(UAutomationGraph* Graph);
+	void Reset();
+
+	// Returns the graphs whose schedules are due, and schedules their next run. CurrentTime is FPlatformTime::Seconds().
+	TArray<UAutomationGraph*> FlushDue(double CurrentTime);
+
+private:
+	struct FScheduledTrigger
+	{
+		TWeakObjectPtr<UAGN_TriggerOnSchedule> Node;
+		TWeakObjectPtr<UAutomationGraph> Graph;
+
+		// Local time.
+		FDateTime Deadline;
+	};
+
+	static bool DeadlineLess(const FScheduledTrigger& A, const FScheduledTrigger& B);
+	void Schedule(const FScheduledTrigger& Trigger);
+	void UpdateNextWakeTime();
+
+	// Ordered by deadline. See TArray::HeapPush().
+	TArray<FScheduledTrigger> DeadlineHeap;
+
+	// The earliest deadline in FPlatformTime::Seconds(), so the per-tick check doesn't need the wall clock.
+	double NextWakeTime = TNumericLimits<double>::Max();
+};
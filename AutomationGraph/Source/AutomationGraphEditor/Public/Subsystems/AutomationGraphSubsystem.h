@@ -32,13 +32,19 @@
 #pragma once
 
 #include "EditorSubsystem.h"
+#include "Foundation/AutomationGraph.h"
 #include "Foundation/AutomationGraphTypes.h"
 #include "IAutomationControllerManager.h"
+#include "Containers/Queue.h"
+#include "Subsystems/AutomationGraphAssetWatcher.h"
+#include "Subsystems/AutomationGraphFileWatcher.h"
+#include "Subsystems/AutomationGraphRunHandle.h"
+#include "Subsystems/AutomationGraphScheduler.h"
 #include "Tickable.h"
 #include "AutomationGraphSubsystem.generated.h"
 
+class FObjectPostSaveContext;
 class UAutomationGraphExecutor;
-class UAutomationGraph;
 class UAutomationGraphNode;
 
 USTRUCT()
@@ -54,6 +60,14 @@ public:
 	FText NewNodeMenuCategory;
 };
 
+// Interactive runs (started from the graph editor) are scheduled ahead of background runs (startup and other
+// automatic triggers). See AutomationGraph.PreemptBackgroundRuns.
+enum class EAutomationGraphTaskPriority : uint8
+{
+	Background,
+	Interactive
+};
+
 UCLASS()
 class AUTOMATIONGRAPHEDITOR_API UAutomationGraphSubsystem : public UEditorSubsystem, public FTickableGameObject
 {
@@ -80,9 +94,22 @@ public:
 	virtual UWorld* GetWorld() const override;
 	//~ End UObject interface
 
-	void EnqueueAutomationGraph(UAutomationGraph* NewGraph, EAutomationGraphNodeTrigger EnqueueReason);
+	// Queued graphs start as soon as their dependencies (UAutomationGraph::Dependencies) have finished. Graphs that
+	// don't depend on each other run side by side.
+	FAutomationGraphRunHandle EnqueueAutomationGraph(UAutomationGraph* NewGraph, EAutomationGraphNodeTrigger EnqueueReason, EAutomationGraphTaskPriority Priority = EAutomationGraphTaskPriority::Background);
+
+	// Same as EnqueueAutomationGraph, but safe to call from any thread. The graph is loaded and queued on the next tick.
+	FAutomationGraphRunHandle SubmitAutomationGraph(const FSoftObjectPath& GraphPath, EAutomationGraphNodeTrigger EnqueueReason, EAutomationGraphTaskPriority Priority = EAutomationGraphTaskPriority::Background);
+
+	// Re-runs only the given nodes and everything downstream of them, at interactive priority. See
+	// FGraphExecutionTask::DirtyNodes.
+	void EnqueueDirtySubgraph(UAutomationGraph* Graph, const TArray<UAutomationGraphNode*>& DirtyNodes);
+
+	// In watch mode, editing a node's properties re-runs that node and everything downstream of it.
+	void SetWatchEnabled(UAutomationGraph* Graph, bool bEnabled);
+	bool IsWatchEnabled(UAutomationGraph* Graph) const;
 	void CancelGraphExecution(UAutomationGraph* Graph);
-	void ClearTaskQueue() { TaskQueue.Empty(); }
+	void ClearTaskQueue();
 	TArray<FAutomationGraphNodeInfo> GetSupportedNodes(UAutomationGraph* Graph);
 
 	// Only one graph node should run tests at a time.
@@ -90,16 +117,98 @@ public:
 	bool ReleaseAutomationController(UAutomationGraphNode* Owner);
 
 protected:
-	void StartExecution(FGraphExecutionTask& ExecutionTask);
+	enum class EDependencyState : uint8
+	{
+		Waiting,
+		Ready,
+		Failed
+	};
+	
+	struct FQueuedGraphTask
+	{
+		FGraphExecutionTask Task;
+		EAutomationGraphTaskPriority Priority = EAutomationGraphTaskPriority::Background;
+		uint64 Sequence = 0;
+
+		// One per submission that was merged into this task.
+		TArray<TSharedPtr<FAutomationGraphRunState, ESPMode::ThreadSafe>> RunStates;
+	};
+
+	struct FGraphRunSubmission
+	{
+		FSoftObjectPath GraphPath;
+		EAutomationGraphNodeTrigger Trigger = EAutomationGraphNodeTrigger::Unknown;
+		EAutomationGraphTaskPriority Priority = EAutomationGraphTaskPriority::Background;
+		TSharedPtr<FAutomationGraphRunState, ESPMode::ThreadSafe> RunState;
+	};
+
+	void DrainSubmissions();
+	void EnqueueRun(UAutomationGraph* NewGraph, EAutomationGraphNodeTrigger EnqueueReason, EAutomationGraphTaskPriority Priority, const TSharedPtr<FAutomationGraphRunState, ESPMode::ThreadSafe>& RunState);
+	FQueuedGraphTask& AddTask(const FGraphExecutionTask& ExecutionTask, EAutomationGraphTaskPriority Priority);
+	static void CompleteTask(FQueuedGraphTask& QueuedTask, bool bSucceeded);
+	// Returns false if the run ended right away (it failed to start, or had nothing to do).
+	bool StartExecution(FQueuedGraphTask& QueuedTask);
+	void StartReadyTasks(bool bHoldBackgroundRuns);
+	void PromoteDependencies();
+	bool HasInteractiveTasks() const;
+	EDependencyState GetDependencyState(const UAutomationGraph* Graph) const;
+	EDependencyState GetDependencyState(const UAutomationGraph* Graph, const FAutomationGraphDependency& Dependency) const;
+	UAutomationGraphExecutor* FindRunningExecutor(const UAutomationGraph* Graph) const;
+	bool IsGraphQueued(UAutomationGraph* Graph) const;
+
+	// A graph that (indirectly) depends on itself would wait forever, so it is never enqueued.
+	static bool HasDependencyCycle(const UAutomationGraph* Graph);
 	void EnqueueStartupGraphs();
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+	void FlushWatchChanges();
+	void OnObjectPreSave(UObject* Object, FObjectPreSaveContext SaveContext);
+	void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+	
+	// Runs submitted from other threads. Lock-free; drained at the start of each tick.
+	TQueue<FGraphRunSubmission, EQueueMode::Mpsc> Submissions;
 	
-	TArray<FGraphExecutionTask> TaskQueue;
+	// Keyed by graph, since a graph is queued at most once. Tasks are put in priority order when they are started.
+	TMap<TWeakObjectPtr<UAutomationGraph>, FQueuedGraphTask> TaskQueue;
+	uint64 NextTaskSequence = 0;
 
+	// The task each running graph was started from.
+	TMap<TWeakObjectPtr<UAutomationGraph>, FQueuedGraphTask> RunningTasks;
+
+	// Edits usually come in bursts (dragging a slider, undo/redo), so changes are collected until there haven't been
+	// any for WatchDebounceSec.
+	TSet<TWeakObjectPtr<UAutomationGraph>> WatchedGraphs;
+	TMap<TWeakObjectPtr<UAutomationGraph>, TSet<TWeakObjectPtr<UAutomationGraphNode>>> PendingWatchChanges;
+	float WatchDebounceTimer = 0.0f;
+	float WatchDebounceSec = 0.5f;
+	FDelegateHandle ObjectPropertyChangedHandle;
+	FDelegateHandle ObjectPreSaveHandle;
+	FDelegateHandle PackageSavedHandle;
+
+	// Test workers are full editors with the plugin loaded. They only run the tests they were given, so they don't run
+	// startup graphs or watch for triggers, which could otherwise launch more workers.
+	bool bIsTestWorker = false;
+
+	// Batches file events for graphs with file triggers. See UAGN_TriggerOnFileChange.
+	FAutomationGraphFileWatcher FileWatcher;
+
+	// Batches asset saves and imports for graphs with asset triggers. See UAGN_TriggerOnAssetChange.
+	FAutomationGraphAssetWatcher AssetWatcher;
+
+	// Deadlines for graphs with schedule triggers. See UAGN_TriggerOnSchedule.
+	FAutomationGraphScheduler Scheduler;
+
+	// Every running graph has its own executor.
 	UPROPERTY()
-	TMap<TSubclassOf<UAutomationGraphExecutor>, TObjectPtr<UAutomationGraphExecutor>> Executors;
+	TArray<TObjectPtr<UAutomationGraphExecutor>> RunningExecutors;
 
+	// Finished executors are kept for reuse. A graph gets back the executor that last ran it, so a partial run still
+	// has the previous run's results.
 	UPROPERTY()
-	TObjectPtr<UAutomationGraphExecutor> CurrentExecutor;
+	TArray<TObjectPtr<UAutomationGraphExecutor>> IdleExecutors;
+
+	// Outcome of the most recent run of each graph. Dependencies on a graph that is no longer queued or running are
+	// resolved against this.
+	TMap<TWeakObjectPtr<UAutomationGraph>, bool> LastRunResults;
 
 	UPROPERTY()
 	TArray<FAutomationGraphNodeInfo>  AllNodeInfo;
@@ -74,6 +74,7 @@ public class AutomationGraphRuntime : ModuleRules
 			{
 				// Core Dependencies (Epic)
 				"Core",
+				"StructUtils",
 			}
 		);
 
@@ -92,6 +93,8 @@ public class AutomationGraphRuntime : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"Json",
+				"JsonUtilities",
 				"Landscape",
 				"Slate",
 				"SlateCore",
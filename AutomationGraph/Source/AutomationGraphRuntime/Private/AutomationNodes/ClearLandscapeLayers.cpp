@@ -34,6 +34,9 @@
 #include "AutomationGraphRuntimeLoggingDefs.h"
 #include "EngineUtils.h"
 #include "Landscape.h"
+#include "LandscapeComponent.h"
+#include "LandscapeEdit.h"
+#include "LandscapeInfo.h"
 #include "Macros/AutomationGraphLoggingMacros.h"
 
 UAGN_ClearLandscapeLayers::UAGN_ClearLandscapeLayers(const FObjectInitializer& Initializer): Super(Initializer)
@@ -43,7 +46,7 @@ UAGN_ClearLandscapeLayers::UAGN_ClearLandscapeLayers(const FObjectInitializer& I
 
 EAutomationGraphNodeState UAGN_ClearLandscapeLayers::ActivateInternal(float DeltaSeconds)
 {
-	if (!TargetLandscape.IsValid())
+	if (TargetLandscapes.IsEmpty())
 	{
 		return SetState(EAutomationGraphNodeState::Error);
 	}
@@ -64,43 +67,156 @@ EAutomationGraphNodeState UAGN_ClearLandscapeLayers::ActivateInternal(float Delt
 			return CurrentState;
 		}
 	}
-	
-	ALandscape* LandscapePtr = TargetLandscape.Get();
-	TMap<FName, ULandscapeLayerInfoObject*> LayerInfoByName;
 
-	ULandscapeInfo* LandscapeInfo = LandscapePtr->GetLandscapeInfo();
-	if (!LandscapeInfo)
+	struct FLandscapeLayers
 	{
-		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("LandscapeInfo is invalid."));
-		return SetState(EAutomationGraphNodeState::Error);
+		ALandscape* Landscape = nullptr;
+		TArray<int32> EditLayerIndices;
+		TArray<ULandscapeLayerInfoObject*> LayerInfos;
+	};
+
+	// Landscapes in the same world don't have to share layers, so a layer only has to exist on one of them. Every layer
+	// is checked before anything is cleared, so that a typo doesn't leave the world half cleared.
+	TArray<FLandscapeLayers> LandscapesToClear;
+	TSet<FName> FoundEditLayers;
+	TSet<FName> FoundPaintLayers;
+	
+	for (const TWeakObjectPtr<ALandscape>& WeakLandscape : TargetLandscapes)
+	{
+		ALandscape* LandscapePtr = WeakLandscape.Get();
+		if (!LandscapePtr)
+		{
+			continue;
+		}
+		
+		ULandscapeInfo* LandscapeInfo = LandscapePtr->GetLandscapeInfo();
+		if (!LandscapeInfo)
+		{
+			AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("LandscapeInfo is invalid for %s."), *LandscapePtr->GetName());
+			return SetState(EAutomationGraphNodeState::Error);
+		}
+
+		TArray<ULandscapeLayerInfoObject*> LayerInfos;
+		for (FName PaintLayerName : PaintLayers)
+		{
+			if (ULandscapeLayerInfoObject* LayerInfo = LandscapeInfo->GetLayerInfoByName(PaintLayerName))
+			{
+				LayerInfos.Add(LayerInfo);
+				FoundPaintLayers.Add(PaintLayerName);
+			}
+		}
+
+		TArray<int32> EditLayerIndices;
+		for (FName EditLayerName : EditLayers)
+		{
+			const int32 EditLayerIndex = LandscapePtr->GetLayerIndex(EditLayerName);
+			if (EditLayerIndex != INDEX_NONE)
+			{
+				EditLayerIndices.Add(EditLayerIndex);
+				FoundEditLayers.Add(EditLayerName);
+			}
+		}
+
+		if (!LayerInfos.IsEmpty() && !EditLayerIndices.IsEmpty())
+		{
+			LandscapesToClear.Add({LandscapePtr, MoveTemp(EditLayerIndices), MoveTemp(LayerInfos)});
+		}
 	}
+
 	for (FName PaintLayerName : PaintLayers)
 	{
-		ULandscapeLayerInfoObject* LayerInfo = LandscapeInfo->GetLayerInfoByName(PaintLayerName);
-		if (!LayerInfo)
+		if (!FoundPaintLayers.Contains(PaintLayerName))
 		{
 			AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("unknown paint layer \"%s\""), *PaintLayerName.ToString());
 			return SetState(EAutomationGraphNodeState::Error);
 		}
-		LayerInfoByName.Add(PaintLayerName, LayerInfo);
 	}
-
 	for (FName EditLayerName : EditLayers)
 	{
-		int32 EditLayerIndex = LandscapePtr->GetLayerIndex(EditLayerName);
-		if (EditLayerIndex == INDEX_NONE)
+		if (!FoundEditLayers.Contains(EditLayerName))
 		{
 			AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("unknown edit layer \"%s\""), *EditLayerName.ToString());
 			return SetState(EAutomationGraphNodeState::Error);
 		}
+	}
 
-		for (FName PaintLayerName : PaintLayers)
+	int32 NumClearedComponents = 0;
+	for (const FLandscapeLayers& LandscapeLayers : LandscapesToClear)
+	{
+		NumClearedComponents += ClearLandscape(*LandscapeLayers.Landscape, LandscapeLayers.EditLayerIndices, LandscapeLayers.LayerInfos);
+	}
+
+	AG_LOG_OBJECT(this, LogAutoGraphRuntime, Log, TEXT("Cleared paint layers on %d landscape components"), NumClearedComponents);
+	return SetState(EAutomationGraphNodeState::Finished);
+}
+
+int32 UAGN_ClearLandscapeLayers::ClearLandscape(ALandscape& Landscape, const TArray<int32>& EditLayerIndices, const TArray<ULandscapeLayerInfoObject*>& LayerInfos)
+{
+	ULandscapeInfo* LandscapeInfo = Landscape.GetLandscapeInfo();
+	int32 NumClearedComponents = 0;
+	
+	for (int32 EditLayerIndex : EditLayerIndices)
+	{
+		const FLandscapeLayer* EditLayer = Landscape.GetLayer(EditLayerIndex);
+		if (!EditLayer)
 		{
-			LandscapePtr->ClearPaintLayer(EditLayerIndex, LayerInfoByName[PaintLayerName]);
+			continue;
 		}
+
+		// Find out what actually needs clearing first, so that layers with nothing painted on them cost nothing.
+		TArray<TPair<ULandscapeComponent*, ULandscapeLayerInfoObject*>> LayersToClear;
+		LandscapeInfo->ForEachLandscapeProxy([&LayersToClear, &LayerInfos, EditLayer](ALandscapeProxy* Proxy)
+		{
+			for (ULandscapeComponent* Component : Proxy->LandscapeComponents)
+			{
+				if (!Component)
+				{
+					continue;
+				}
+				
+				for (const FWeightmapLayerAllocationInfo& Allocation : Component->GetWeightmapLayerAllocations(EditLayer->Guid))
+				{
+					if (LayerInfos.Contains(Allocation.LayerInfo))
+					{
+						LayersToClear.Emplace(Component, Allocation.LayerInfo);
+					}
+				}
+			}
+			return true;
+		});
+
+		if (LayersToClear.IsEmpty())
+		{
+			continue;
+		}
+
+		// Unlike ALandscape::ClearPaintLayer(), this doesn't request an update for every layer. The whole landscape
+		// gets a single update once every layer has been cleared.
+		FScopedSetLandscapeEditingLayer EditingLayerScope(&Landscape, EditLayer->Guid);
+		FLandscapeEditDataInterface LandscapeEdit(LandscapeInfo);
+
+		TSet<ULandscapeComponent*> ClearedComponents;
+		for (const TPair<ULandscapeComponent*, ULandscapeLayerInfoObject*>& LayerToClear : LayersToClear)
+		{
+			ULandscapeComponent* Component = LayerToClear.Key;
+			if (!ClearedComponents.Contains(Component))
+			{
+				Component->GetLandscapeProxy()->Modify();
+				ClearedComponents.Add(Component);
+			}
+			
+			Component->DeleteLayer(LayerToClear.Value, LandscapeEdit);
+		}
+
+		NumClearedComponents += ClearedComponents.Num();
 	}
-	
-	return SetState(EAutomationGraphNodeState::Finished);
+
+	if (NumClearedComponents > 0)
+	{
+		Landscape.RequestLayersContentUpdateForceAll(ELandscapeLayerUpdateMode::Update_Weightmap_All);
+	}
+
+	return NumClearedComponents;
 }
 
 bool UAGN_ClearLandscapeLayers::Initialize(UWorld* World)
@@ -112,23 +228,14 @@ bool UAGN_ClearLandscapeLayers::Initialize(UWorld* World)
 		return false;
 	}
 
+	// Streaming proxies (including World Partition landscapes) are reached through their parent landscape's info.
+	TargetLandscapes.Empty();
 	for (TActorIterator<ALandscape> ActorItr(World); ActorItr; ++ActorItr)
 	{
-		AActor* CurrentActor = *ActorItr;
-		auto* LandscapeActor = Cast<ALandscape>(CurrentActor);
-
-		if (!LandscapeActor)
-		{
-			continue;
-		}
-
-		// Note: For now, we just grab the first landscape we can find. Technically a world can have more than one
-		//       Landscape, although this generally is not recommended.
-		TargetLandscape = LandscapeActor;
-		break;
+		TargetLandscapes.Add(*ActorItr);
 	}
 
-	if (!TargetLandscape.IsValid())
+	if (TargetLandscapes.IsEmpty())
 	{
 		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Failed to initialize ClearLandscapeLayers node: Landscape is missing."));
 		SetState(EAutomationGraphNodeState::Error);
@@ -136,4 +243,4 @@ bool UAGN_ClearLandscapeLayers::Initialize(UWorld* World)
 	}
 
 	return Super::Initialize(World);
-}
+}
\ No newline at end of file
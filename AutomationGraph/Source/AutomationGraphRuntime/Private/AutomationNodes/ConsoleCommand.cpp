@@ -32,8 +32,12 @@
 #include "AutomationNodes/ConsoleCommand.h"
 
 #include "AutomationGraphRuntimeLoggingDefs.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
 #include "Macros/AutomationGraphLoggingMacros.h"
 
+const FName UAGN_BatchConsoleCommand::FailedCommandsOutputName = TEXT("FailedCommands");
+
 bool UAGN_ConsoleCommandBase::Initialize(UWorld* NewWorld)
 {
 	if (!NewWorld)
@@ -93,4 +97,114 @@ EAutomationGraphNodeState UAGN_ConsoleCommandBase::ActivateInternal(float DeltaS
 UAGN_ConsoleCommand::UAGN_ConsoleCommand(const FObjectInitializer& Initializer) : Super(Initializer)
 {
 	Title = FText::FromString("Console Command");
+}
+
+UAGN_BatchConsoleCommand::UAGN_BatchConsoleCommand(const FObjectInitializer& Initializer) : Super(Initializer)
+{
+	Title = FText::FromString("Batch Console Command");
+}
+
+void UAGN_BatchConsoleCommand::GetOutputSlots(TArray<FAutomationGraphDataSlot>& OutSlots)
+{
+	OutSlots.Emplace(FailedCommandsOutputName, FAutomationGraphStringList::StaticStruct());
+}
+
+EAutomationGraphNodeState UAGN_BatchConsoleCommand::ActivateInternal(float DeltaSeconds)
+{
+	if (!GEngine)
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("GEngine is invalid."));
+		return SetState(EAutomationGraphNodeState::Error);
+	}
+
+	// Activate and run in the same frame, there is nothing to wait for.
+	{
+		EAutomationGraphNodeState CurrentState = GetState();
+		if (CurrentState == EAutomationGraphNodeState::Standby)
+		{
+			SetState(EAutomationGraphNodeState::Active);
+		}
+		else if (CurrentState != EAutomationGraphNodeState::Active)
+		{
+			return CurrentState;
+		}
+	}
+
+	FAutomationGraphStringList* FailedCommands = WriteOutput<FAutomationGraphStringList>(FailedCommandsOutputName);
+	TArray<FString> Failures;
+	
+	TArray<UWorld*> CommandWorlds;
+	GetCommandWorlds(CommandWorlds, Failures);
+	
+	for (const FString& Command : Commands)
+	{
+		if (bStopOnFailure && !Failures.IsEmpty())
+		{
+			break;
+		}
+		if (Command.IsEmpty())
+		{
+			continue;
+		}
+
+		for (UWorld* World : CommandWorlds)
+		{
+			if (!GEngine->Exec(World, *Command))
+			{
+				AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Command failed in %s: %s"), *World->GetName(), *Command);
+				Failures.Add(FString::Printf(TEXT("%s (%s)"), *Command, *World->GetName()));
+			}
+		}
+	}
+
+	if (FailedCommands)
+	{
+		FailedCommands->Values = Failures;
+	}
+	
+	return SetState(Failures.IsEmpty() ? EAutomationGraphNodeState::Finished : EAutomationGraphNodeState::Error);
+}
+
+void UAGN_BatchConsoleCommand::GetCommandWorlds(TArray<UWorld*>& OutWorlds, TArray<FString>& OutFailures) const
+{
+	OutWorlds.Empty();
+
+	if (TargetWorlds == EAutomationGraphCommandWorlds::GraphWorld)
+	{
+		if (!TargetWorld.IsValid())
+		{
+			AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("TargetWorld is invalid."));
+			OutFailures.Add(TEXT("TargetWorld is invalid"));
+			return;
+		}
+		
+		OutWorlds.Add(TargetWorld.Get());
+		return;
+	}
+
+	if (TargetWorlds == EAutomationGraphCommandWorlds::AllOpenWorlds)
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (World && (Context.WorldType == EWorldType::Editor || Context.WorldType == EWorldType::PIE))
+			{
+				OutWorlds.Add(World);
+			}
+		}
+		return;
+	}
+
+	for (const TSoftObjectPtr<UWorld>& ListedWorld : Worlds)
+	{
+		if (UWorld* World = ListedWorld.Get())
+		{
+			OutWorlds.AddUnique(World);
+		}
+		else
+		{
+			AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("%s is not loaded."), *ListedWorld.ToString());
+			OutFailures.Add(FString::Printf(TEXT("%s is not loaded"), *ListedWorld.ToString()));
+		}
+	}
 }
\ No newline at end of file
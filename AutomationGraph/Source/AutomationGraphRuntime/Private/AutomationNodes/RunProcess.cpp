@@ -0,0 +1,313 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "AutomationNodes/RunProcess.h"
+
+#include "AutomationGraphRuntimeLoggingDefs.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "Macros/AutomationGraphLoggingMacros.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<int32> CVarMaxProcessJobs(
+	TEXT("AutomationGraph.MaxProcessJobs"),
+	0,
+	TEXT("Maximum number of Run Process nodes that can have a process running at once, across all graphs. 0 uses the number of logical cores.")
+);
+
+const FName UAGN_RunProcess::OutputLinesOutputName = TEXT("OutputLines");
+
+namespace
+{
+	// Only touched from the game thread.
+	int32 NumRunningProcessJobs = 0;
+
+	int32 GetMaxProcessJobs()
+	{
+		const int32 MaxJobs = CVarMaxProcessJobs.GetValueOnGameThread();
+		return MaxJobs > 0 ? MaxJobs : FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	}
+}
+
+UAGN_RunProcess::UAGN_RunProcess(const FObjectInitializer& Initializer): Super(Initializer)
+{
+	Title = FText::FromString("Run Process");
+
+	// Builds, cooks and other external tools have no natural upper bound on how long they run.
+	NodeTimeoutSec = TNumericLimits<float>::Max();
+}
+
+void UAGN_RunProcess::BeginDestroy()
+{
+	// A node that is destroyed mid-run (graph closed, editor shutting down) must not take its job slot with it.
+	ReleaseProcess();
+	
+	Super::BeginDestroy();
+}
+
+bool UAGN_RunProcess::Initialize(UWorld* World)
+{
+	if (!Super::Initialize(World))
+	{
+		return false;
+	}
+
+	ReleaseProcess();
+	PendingStdOut.Empty();
+	PendingStdErr.Empty();
+	OutputLines.Empty();
+	
+	return true;
+}
+
+void UAGN_RunProcess::Cleanup()
+{
+	ReleaseProcess();
+}
+
+void UAGN_RunProcess::GetOutputSlots(TArray<FAutomationGraphDataSlot>& OutSlots)
+{
+	OutSlots.Emplace(OutputLinesOutputName, FAutomationGraphStringList::StaticStruct());
+}
+
+FString UAGN_RunProcess::GetMessageText()
+{
+	if (GetState() == EAutomationGraphNodeState::Active && !bHasJobSlot)
+	{
+		return FString::Printf(TEXT("Waiting for a job slot (%d/%d in use)"), NumRunningProcessJobs, GetMaxProcessJobs());
+	}
+
+	return Super::GetMessageText();
+}
+
+EAutomationGraphNodeState UAGN_RunProcess::ActivateInternal(float DeltaSeconds)
+{
+	if (Executable.IsEmpty())
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Executable is empty."));
+		return SetState(EAutomationGraphNodeState::Error);
+	}
+	
+	// Standard activation, ensures the node is active past this block.
+	{
+		EAutomationGraphNodeState CurrentState = GetState();
+		if (CurrentState == EAutomationGraphNodeState::Standby)
+		{
+			return SetState(EAutomationGraphNodeState::Active);
+		}
+		if (CurrentState != EAutomationGraphNodeState::Active)
+		{
+			return CurrentState;
+		}
+	}
+
+	if (!Process.IsValid())
+	{
+		if (!AcquireJobSlot())
+		{
+			return EAutomationGraphNodeState::Active;
+		}
+		
+		if (!LaunchProcess())
+		{
+			ReleaseProcess();
+			return SetState(EAutomationGraphNodeState::Error);
+		}
+
+		return EAutomationGraphNodeState::Active;
+	}
+
+	ReadPipes(false);
+	if (FPlatformProcess::IsProcRunning(Process))
+	{
+		return EAutomationGraphNodeState::Active;
+	}
+
+	// The process can exit with output still sitting in the pipes.
+	ReadPipes(true);
+
+	int32 ExitCode = 0;
+	FPlatformProcess::GetProcReturnCode(Process, &ExitCode);
+	ReleaseProcess();
+	
+	if (FAutomationGraphStringList* Output = WriteOutput<FAutomationGraphStringList>(OutputLinesOutputName))
+	{
+		Output->Values = MoveTemp(OutputLines);
+	}
+
+	const EAutomationGraphNodeState ExitState = GetExitState(ExitCode);
+	if (ExitState == EAutomationGraphNodeState::Finished)
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Log, TEXT("%s exited with code %d"), *Executable, ExitCode);
+	}
+	else
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("%s exited with code %d"), *Executable, ExitCode);
+	}
+	
+	return SetState(ExitState);
+}
+
+bool UAGN_RunProcess::AcquireJobSlot()
+{
+	if (!bHasJobSlot && NumRunningProcessJobs < GetMaxProcessJobs())
+	{
+		NumRunningProcessJobs++;
+		bHasJobSlot = true;
+	}
+
+	return bHasJobSlot;
+}
+
+bool UAGN_RunProcess::LaunchProcess()
+{
+	FString ExecutablePath = Executable;
+	const FString ProjectRelativePath = FPaths::Combine(FPaths::ProjectDir(), Executable);
+	if (FPaths::IsRelative(Executable) && FPaths::FileExists(ProjectRelativePath))
+	{
+		ExecutablePath = FPaths::ConvertRelativePathToFull(ProjectRelativePath);
+	}
+	
+	FString ProcessDirectory = WorkingDirectory.IsEmpty() ? FPaths::ProjectDir() : WorkingDirectory;
+	if (FPaths::IsRelative(ProcessDirectory))
+	{
+		ProcessDirectory = FPaths::Combine(FPaths::ProjectDir(), ProcessDirectory);
+	}
+	ProcessDirectory = FPaths::ConvertRelativePathToFull(ProcessDirectory);
+
+	if (!FPlatformProcess::CreatePipe(StdOutRead, StdOutWrite) || !FPlatformProcess::CreatePipe(StdErrRead, StdErrWrite))
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Failed to create output pipes."));
+		return false;
+	}
+
+	Process = FPlatformProcess::CreateProc(*ExecutablePath, *Arguments, false, true, true, nullptr, 0, *ProcessDirectory, StdOutWrite, nullptr, StdErrWrite);
+	if (!Process.IsValid())
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Failed to launch %s"), *ExecutablePath);
+		return false;
+	}
+
+	AG_LOG_OBJECT(this, LogAutoGraphRuntime, Log, TEXT("Launched %s %s"), *ExecutablePath, *Arguments);
+	return true;
+}
+
+void UAGN_RunProcess::ReleaseProcess()
+{
+	if (Process.IsValid())
+	{
+		if (FPlatformProcess::IsProcRunning(Process))
+		{
+			FPlatformProcess::TerminateProc(Process, true);
+		}
+		FPlatformProcess::CloseProc(Process);
+	}
+
+	if (StdOutRead || StdOutWrite)
+	{
+		FPlatformProcess::ClosePipe(StdOutRead, StdOutWrite);
+		StdOutRead = nullptr;
+		StdOutWrite = nullptr;
+	}
+	if (StdErrRead || StdErrWrite)
+	{
+		FPlatformProcess::ClosePipe(StdErrRead, StdErrWrite);
+		StdErrRead = nullptr;
+		StdErrWrite = nullptr;
+	}
+
+	if (bHasJobSlot)
+	{
+		NumRunningProcessJobs--;
+		bHasJobSlot = false;
+	}
+}
+
+void UAGN_RunProcess::ReadPipes(bool bFlush)
+{
+	ReadPipe(StdOutRead, PendingStdOut, false, bFlush);
+	ReadPipe(StdErrRead, PendingStdErr, true, bFlush);
+}
+
+void UAGN_RunProcess::ReadPipe(void* Pipe, FString& PendingText, bool bStdErr, bool bFlush)
+{
+	// ReadPipe() only returns what is already buffered, it never waits for the process.
+	for (FString NewText = FPlatformProcess::ReadPipe(Pipe); !NewText.IsEmpty(); NewText = FPlatformProcess::ReadPipe(Pipe))
+	{
+		PendingText += NewText;
+	}
+
+	int32 LineEnd = INDEX_NONE;
+	while (PendingText.FindChar(TEXT('\n'), LineEnd))
+	{
+		HandleLine(PendingText.Left(LineEnd), bStdErr);
+		PendingText.RightChopInline(LineEnd + 1);
+	}
+
+	if (bFlush && !PendingText.IsEmpty())
+	{
+		HandleLine(MoveTemp(PendingText), bStdErr);
+		PendingText.Empty();
+	}
+}
+
+void UAGN_RunProcess::HandleLine(FString Line, bool bStdErr)
+{
+	// Windows tools end their lines with \r\n.
+	Line.TrimEndInline();
+	
+	if (bStdErr)
+	{
+		if (bLogOutput)
+		{
+			AG_LOG_OBJECT(this, LogAutoGraphRuntime, Warning, TEXT("%s"), *Line);
+		}
+		return;
+	}
+
+	if (bLogOutput)
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Log, TEXT("%s"), *Line);
+	}
+	OutputLines.Add(MoveTemp(Line));
+}
+
+EAutomationGraphNodeState UAGN_RunProcess::GetExitState(int32 ExitCode) const
+{
+	// Only finished states make sense here, anything else would leave the node running forever.
+	const EAutomationGraphNodeState* MappedState = ExitCodeStates.Find(ExitCode);
+	if (MappedState && *MappedState >= EAutomationGraphNodeState::Finished)
+	{
+		return *MappedState;
+	}
+
+	return ExitCode == 0 ? EAutomationGraphNodeState::Finished : EAutomationGraphNodeState::Error;
+}
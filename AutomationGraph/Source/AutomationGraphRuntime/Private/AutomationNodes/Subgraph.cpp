@@ -0,0 +1,206 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "AutomationNodes/Subgraph.h"
+
+#include "AutomationGraphRuntimeLoggingDefs.h"
+#include "Foundation/AutomationGraph.h"
+#include "Foundation/AutomationGraphExecutor.h"
+#include "Foundation/AutomationGraphPlan.h"
+#include "Macros/AutomationGraphLoggingMacros.h"
+
+UAGN_Subgraph::UAGN_Subgraph(const FObjectInitializer& Initializer): Super(Initializer)
+{
+	Title = FText::FromString("Subgraph");
+
+	// The nodes inside the subgraph have their own timeouts.
+	NodeTimeoutSec = TNumericLimits<float>::Max();
+}
+
+bool UAGN_Subgraph::Initialize(UWorld* World)
+{
+	if (!Super::Initialize(World))
+	{
+		return false;
+	}
+
+	TargetWorld = World;
+
+	if (!Graph)
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("No graph selected."));
+		SetState(EAutomationGraphNodeState::Error);
+		return false;
+	}
+
+	// Nested subgraphs run in transient instances, so graphs are compared by the asset they were made from. A cycle
+	// anywhere below Graph is caught too, not just one that leads back to this graph.
+	TArray<const UAutomationGraph*> Path;
+	TSet<const UAutomationGraph*> Finished;
+	if (UAutomationGraph* OuterGraph = GetTypedOuter<UAutomationGraph>())
+	{
+		Path.Add(OuterGraph->GetSourceGraph());
+	}
+
+	if (FindCycle(Graph, Path, Finished))
+	{
+		TArray<FString> CycleNames;
+		for (const UAutomationGraph* CycleGraph : Path)
+		{
+			CycleNames.Add(CycleGraph->GetName());
+		}
+		
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("%s can't be used as a subgraph here, since it would run forever: %s"), *Graph->GetName(), *FString::Join(CycleNames, TEXT(" -> ")));
+		SetState(EAutomationGraphNodeState::Error);
+		return false;
+	}
+	
+	return true;
+}
+
+void UAGN_Subgraph::Cleanup()
+{
+	if (SubgraphExecutor && GraphInstance && SubgraphExecutor->IsRunning())
+	{
+		SubgraphExecutor->Cancel(GraphInstance);
+	}
+	
+	SubgraphExecutor = nullptr;
+	GraphInstance = nullptr;
+}
+
+FString UAGN_Subgraph::GetMessageText()
+{
+	if (Graph && GetState() == EAutomationGraphNodeState::Active)
+	{
+		return FString::Printf(TEXT("Running %s"), *Graph->GetName());
+	}
+	
+	return Super::GetMessageText();
+}
+
+EAutomationGraphNodeState UAGN_Subgraph::ActivateInternal(float DeltaSeconds)
+{
+	// Standard activation, ensures the node is active past this block.
+	{
+		EAutomationGraphNodeState CurrentState = GetState();
+		if (CurrentState == EAutomationGraphNodeState::Standby)
+		{
+			return SetState(EAutomationGraphNodeState::Active);
+		}
+		if (CurrentState != EAutomationGraphNodeState::Active)
+		{
+			return CurrentState;
+		}
+	}
+
+	if (!SubgraphExecutor && !StartSubgraph())
+	{
+		return SetState(EAutomationGraphNodeState::Error);
+	}
+
+	if (SubgraphExecutor->Execute(DeltaSeconds))
+	{
+		return EAutomationGraphNodeState::Active;
+	}
+
+	return SetState(SubgraphExecutor->DidLastRunSucceed() ? EAutomationGraphNodeState::Finished : EAutomationGraphNodeState::Error);
+}
+
+void UAGN_Subgraph::CancelInternal()
+{
+	if (SubgraphExecutor && GraphInstance && SubgraphExecutor->IsRunning())
+	{
+		SubgraphExecutor->Cancel(GraphInstance);
+	}
+}
+
+bool UAGN_Subgraph::StartSubgraph()
+{
+	FString Error;
+	TSharedPtr<const FAutomationGraphPlan> Plan = FAutomationGraphPlan::Get(Graph, Error);
+	if (!Plan.IsValid())
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Failed to compile subgraph: %s"), *Error);
+		return false;
+	}
+
+	GraphInstance = Plan->Instantiate(this);
+	if (!GraphInstance)
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Failed to instantiate %s."), *Graph->GetName());
+		return false;
+	}
+
+	SubgraphExecutor = NewObject<UAutomationGraphExecutor>(this, GraphInstance->GetExecutorType(), NAME_None, RF_Transient);
+
+	FGraphExecutionTask ExecutionTask(GraphInstance, TargetWorld, EAutomationGraphNodeTrigger::OnPlay);
+	SubgraphExecutor->StartExecution(ExecutionTask);
+
+	// If the subgraph failed to start, Execute() returns false straight away and DidLastRunSucceed() is false.
+	return true;
+}
+
+bool UAGN_Subgraph::FindCycle(UAutomationGraph* SearchGraph, TArray<const UAutomationGraph*>& Path, TSet<const UAutomationGraph*>& Finished)
+{
+	SearchGraph = SearchGraph->GetSourceGraph();
+	
+	const int32 PathIndex = Path.Find(SearchGraph);
+	if (PathIndex != INDEX_NONE)
+	{
+		Path.RemoveAt(0, PathIndex);
+		Path.Add(SearchGraph);
+		return true;
+	}
+	if (Finished.Contains(SearchGraph))
+	{
+		return false;
+	}
+
+	FString Error;
+	TSharedPtr<const FAutomationGraphPlan> Plan = FAutomationGraphPlan::Get(SearchGraph, Error);
+	if (Plan.IsValid())
+	{
+		Path.Add(SearchGraph);
+		for (TWeakObjectPtr<UAutomationGraphNode> Node : Plan->Nodes)
+		{
+			auto* SubgraphNode = Cast<UAGN_Subgraph>(Node.Get());
+			if (SubgraphNode && SubgraphNode->Graph && FindCycle(SubgraphNode->Graph, Path, Finished))
+			{
+				return true;
+			}
+		}
+		Path.Pop(EAllowShrinking::No);
+	}
+
+	Finished.Add(SearchGraph);
+	return false;
+}
@@ -0,0 +1,131 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "AutomationNodes/TriggerOnAssetChange.h"
+
+#include "Foundation/AutomationGraphResultTable.h"
+
+const FName UAGN_TriggerOnAssetChange::ChangedAssetsOutputName = TEXT("ChangedAssets");
+
+UAGN_TriggerOnAssetChange::UAGN_TriggerOnAssetChange(const FObjectInitializer& Initializer): Super(Initializer)
+{
+	Title = FText::FromString("On Asset Change");
+}
+
+TArray<EAutomationGraphNodeTrigger> UAGN_TriggerOnAssetChange::GetTriggers()
+{
+	TArray<EAutomationGraphNodeTrigger> Triggers;
+	Triggers.Add(EAutomationGraphNodeTrigger::OnAssetChange);
+
+	if (bTriggerOnPlay)
+	{
+		Triggers.Add(EAutomationGraphNodeTrigger::OnPlay);
+	}
+
+	return Triggers;
+}
+
+void UAGN_TriggerOnAssetChange::GetOutputSlots(TArray<FAutomationGraphDataSlot>& OutSlots)
+{
+	OutSlots.Emplace(ChangedAssetsOutputName, FAutomationGraphAssetList::StaticStruct());
+}
+
+bool UAGN_TriggerOnAssetChange::MatchesAsset(const UObject* Asset) const
+{
+	if (!Asset)
+	{
+		return false;
+	}
+
+	const FString PackageName = Asset->GetPackage()->GetName();
+	bool bPathMatches = false;
+	for (const FString& Filter : PathFilters)
+	{
+		if (PackageName.MatchesWildcard(Filter))
+		{
+			bPathMatches = true;
+			break;
+		}
+	}
+
+	if (!bPathMatches)
+	{
+		return false;
+	}
+
+	if (ClassFilters.IsEmpty())
+	{
+		return true;
+	}
+	
+	for (TSubclassOf<UObject> Filter : ClassFilters)
+	{
+		if (Filter && Asset->IsA(Filter))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UAGN_TriggerOnAssetChange::AddChangedAssets(const TArray<FSoftObjectPath>& Assets)
+{
+	for (const FSoftObjectPath& Asset : Assets)
+	{
+		PendingAssets.AddUnique(Asset);
+	}
+}
+
+EAutomationGraphNodeState UAGN_TriggerOnAssetChange::ActivateInternal(float DeltaSeconds)
+{
+	// Standard activation, ensures the node is active past this block.
+	{
+		EAutomationGraphNodeState CurrentState = GetState();
+		if (CurrentState == EAutomationGraphNodeState::Standby)
+		{
+			return SetState(EAutomationGraphNodeState::Active);
+		}
+		if (CurrentState != EAutomationGraphNodeState::Active)
+		{
+			return CurrentState;
+		}
+	}
+
+	// Changes that arrive after this point are kept for the next run.
+	if (FAutomationGraphAssetList* ChangedAssets = WriteOutput<FAutomationGraphAssetList>(ChangedAssetsOutputName))
+	{
+		ChangedAssets->Assets = MoveTemp(PendingAssets);
+	}
+	PendingAssets.Reset();
+
+	return SetState(EAutomationGraphNodeState::Finished);
+}
@@ -0,0 +1,144 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "AutomationNodes/TriggerOnFileChange.h"
+
+#include "Foundation/AutomationGraphResultTable.h"
+#include "Misc/Paths.h"
+
+const FName UAGN_TriggerOnFileChange::ChangedFilesOutputName = TEXT("ChangedFiles");
+
+UAGN_TriggerOnFileChange::UAGN_TriggerOnFileChange(const FObjectInitializer& Initializer): Super(Initializer)
+{
+	Title = FText::FromString("On File Change");
+}
+
+TArray<EAutomationGraphNodeTrigger> UAGN_TriggerOnFileChange::GetTriggers()
+{
+	TArray<EAutomationGraphNodeTrigger> Triggers;
+	Triggers.Add(EAutomationGraphNodeTrigger::OnFileChange);
+
+	if (bTriggerOnPlay)
+	{
+		Triggers.Add(EAutomationGraphNodeTrigger::OnPlay);
+	}
+
+	return Triggers;
+}
+
+void UAGN_TriggerOnFileChange::GetOutputSlots(TArray<FAutomationGraphDataSlot>& OutSlots)
+{
+	OutSlots.Emplace(ChangedFilesOutputName, FAutomationGraphStringList::StaticStruct());
+}
+
+TArray<FString> UAGN_TriggerOnFileChange::GetWatchedDirectories() const
+{
+	TArray<FString> WatchedDirectories;
+	for (const FDirectoryPath& Directory : Directories)
+	{
+		if (Directory.Path.IsEmpty())
+		{
+			continue;
+		}
+
+		FString FullPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), Directory.Path);
+		FPaths::NormalizeDirectoryName(FullPath);
+		WatchedDirectories.AddUnique(FullPath);
+	}
+
+	return WatchedDirectories;
+}
+
+bool UAGN_TriggerOnFileChange::MatchesFilters(const FString& RelativePath) const
+{
+	if (!bIncludeSubdirectories && RelativePath.Contains(TEXT("/")))
+	{
+		return false;
+	}
+	
+	bool bIncluded = false;
+	for (const FString& Filter : IncludeFilters)
+	{
+		if (RelativePath.MatchesWildcard(Filter))
+		{
+			bIncluded = true;
+			break;
+		}
+	}
+
+	if (!bIncluded)
+	{
+		return false;
+	}
+
+	for (const FString& Filter : ExcludeFilters)
+	{
+		if (RelativePath.MatchesWildcard(Filter))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UAGN_TriggerOnFileChange::AddChangedFiles(const TArray<FString>& Files)
+{
+	for (const FString& File : Files)
+	{
+		PendingFiles.AddUnique(File);
+	}
+}
+
+EAutomationGraphNodeState UAGN_TriggerOnFileChange::ActivateInternal(float DeltaSeconds)
+{
+	// Standard activation, ensures the node is active past this block.
+	{
+		EAutomationGraphNodeState CurrentState = GetState();
+		if (CurrentState == EAutomationGraphNodeState::Standby)
+		{
+			return SetState(EAutomationGraphNodeState::Active);
+		}
+		if (CurrentState != EAutomationGraphNodeState::Active)
+		{
+			return CurrentState;
+		}
+	}
+
+	// Changes that arrive after this point are kept for the next run.
+	if (FAutomationGraphStringList* ChangedFiles = WriteOutput<FAutomationGraphStringList>(ChangedFilesOutputName))
+	{
+		ChangedFiles->Values = MoveTemp(PendingFiles);
+	}
+	PendingFiles.Reset();
+
+	return SetState(EAutomationGraphNodeState::Finished);
+}
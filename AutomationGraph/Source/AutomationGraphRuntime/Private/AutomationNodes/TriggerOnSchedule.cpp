@@ -0,0 +1,72 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "AutomationNodes/TriggerOnSchedule.h"
+
+#include "AutomationGraphRuntimeLoggingDefs.h"
+#include "Foundation/AutomationGraphSchedule.h"
+#include "Macros/AutomationGraphLoggingMacros.h"
+
+UAGN_TriggerOnSchedule::UAGN_TriggerOnSchedule(const FObjectInitializer& Initializer): Super(Initializer)
+{
+	Title = FText::FromString("On Schedule");
+}
+
+TArray<EAutomationGraphNodeTrigger> UAGN_TriggerOnSchedule::GetTriggers()
+{
+	TArray<EAutomationGraphNodeTrigger> Triggers;
+	Triggers.Add(EAutomationGraphNodeTrigger::OnSchedule);
+
+	if (bTriggerOnPlay)
+	{
+		Triggers.Add(EAutomationGraphNodeTrigger::OnPlay);
+	}
+
+	return Triggers;
+}
+
+FDateTime UAGN_TriggerOnSchedule::GetNextRunTime(const FDateTime& After) const
+{
+	if (ScheduleType == EAutomationGraphScheduleType::Interval)
+	{
+		return After + FTimespan::FromMinutes(FMath::Max(IntervalMinutes, 1.0f));
+	}
+
+	FAutomationGraphCronExpression Cron;
+	FString Error;
+	if (!FAutomationGraphCronExpression::Parse(CronExpression, Cron, Error))
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Invalid cron expression: %s"), *Error);
+		return FDateTime::MaxValue();
+	}
+
+	return Cron.GetNextTime(After);
+}
@@ -0,0 +1,345 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Benchmark/AutomationGraphBenchmark.h"
+
+#include "AutomationGraphRuntimeLoggingDefs.h"
+#include "JsonObjectConverter.h"
+#include "AutomationNodes/SyntheticWork.h"
+#include "Foundation/AutomationGraph.h"
+#include "Foundation/AutomationGraphExecutor.h"
+#include "Macros/AutomationGraphLoggingMacros.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectArray.h"
+
+namespace AutomationGraphBenchmark
+{
+	static int32 GetObjectCount()
+	{
+		return GUObjectArray.GetObjectArrayNumMinusAvailable();
+	}
+
+	static int64 CountMemory(const TArray<UObject*>& Objects)
+	{
+		int64 Bytes = 0;
+		for (UObject* Object : Objects)
+		{
+			FArchiveCountMem CountMem(Object);
+			Bytes += CountMem.GetMax();
+		}
+
+		return Bytes;
+	}
+
+	struct FSyntheticGraphBuilder
+	{
+		FSyntheticGraphBuilder(const FAutomationGraphBenchmarkSettings& InSettings): Settings(InSettings), RandomStream(InSettings.RandomSeed)
+		{
+			Graph = NewObject<UAutomationGraph>(GetTransientPackage(), NAME_None, RF_Transient);
+			Graph->bRecordExecutionHistory = false;
+		}
+
+		UAGN_SyntheticWork* AddNode()
+		{
+			auto* Node = NewObject<UAGN_SyntheticWork>(Graph, NAME_None, RF_Transient);
+			Node->DurationSec = Settings.NodeDurationSec;
+			Node->FailureRate = Settings.NodeFailureRate;
+			Node->RandomSeed = RandomStream.RandHelper(MAX_int32);
+			Nodes.Add(Node);
+			return Node;
+		}
+
+		void AddEdge(UAutomationGraphNode* Parent, UAutomationGraphNode* Child)
+		{
+			Parent->ChildNodes.Add(Child);
+			Child->ParentNodes.Add(Parent);
+			EdgeCount++;
+		}
+
+		void Build(EAutomationGraphBenchmarkShape Shape, int32 NodeCount)
+		{
+			Nodes.Reserve(NodeCount);
+			
+			switch (Shape)
+			{
+			case EAutomationGraphBenchmarkShape::Chain:
+				AddNode();
+				for (int32 NodeIndex = 1; NodeIndex < NodeCount; ++NodeIndex)
+				{
+					UAutomationGraphNode* Previous = Nodes.Last();
+					AddEdge(Previous, AddNode());
+				}
+				break;
+			case EAutomationGraphBenchmarkShape::FanOut:
+				{
+					UAutomationGraphNode* Root = AddNode();
+					for (int32 NodeIndex = 1; NodeIndex < NodeCount; ++NodeIndex)
+					{
+						AddEdge(Root, AddNode());
+					}
+				}
+				break;
+			case EAutomationGraphBenchmarkShape::FanIn:
+				{
+					UAutomationGraphNode* Sink = AddNode();
+					for (int32 NodeIndex = 1; NodeIndex < NodeCount; ++NodeIndex)
+					{
+						AddEdge(AddNode(), Sink);
+					}
+				}
+				break;
+			case EAutomationGraphBenchmarkShape::Diamond:
+				{
+					// Stacked diamonds: Top -> (Left, Right) -> Bottom, where each Bottom is the next Top.
+					UAutomationGraphNode* Top = AddNode();
+					while (Nodes.Num() + 3 <= NodeCount)
+					{
+						UAutomationGraphNode* Left = AddNode();
+						UAutomationGraphNode* Right = AddNode();
+						UAutomationGraphNode* Bottom = AddNode();
+						AddEdge(Top, Left);
+						AddEdge(Top, Right);
+						AddEdge(Left, Bottom);
+						AddEdge(Right, Bottom);
+						Top = Bottom;
+					}
+				}
+				break;
+			case EAutomationGraphBenchmarkShape::RandomDAG:
+				for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
+				{
+					UAutomationGraphNode* Node = AddNode();
+					
+					// Edges only point from lower to higher indices, so the result is always acyclic.
+					int32 NumParents = FMath::Min(NodeIndex, RandomStream.RandRange(0, 3));
+					TSet<int32> ParentIndices;
+					for (int32 ParentCount = 0; ParentCount < NumParents; ++ParentCount)
+					{
+						int32 ParentIndex = RandomStream.RandRange(0, NodeIndex - 1);
+						if (!ParentIndices.Contains(ParentIndex))
+						{
+							ParentIndices.Add(ParentIndex);
+							AddEdge(Nodes[ParentIndex], Node);
+						}
+					}
+				}
+				break;
+			default:
+				break;
+			}
+
+			for (UAutomationGraphNode* Node : Nodes)
+			{
+				if (Node->ParentNodes.IsEmpty())
+				{
+					Graph->RootNodes.Add(Node);
+				}
+			}
+		}
+
+		const FAutomationGraphBenchmarkSettings& Settings;
+		FRandomStream RandomStream;
+		
+		UAutomationGraph* Graph = nullptr;
+		TArray<UAutomationGraphNode*> Nodes;
+		int32 EdgeCount = 0;
+	};
+}
+
+void FAutomationGraphBenchmark::Run(UWorld* World, const FAutomationGraphBenchmarkSettings& Settings, FAutomationGraphBenchmarkReport& OutReport)
+{
+	UEnum* ShapeEnum = StaticEnum<EAutomationGraphBenchmarkShape>();
+	for (int32 ShapeIndex = 0; ShapeIndex < ShapeEnum->NumEnums() - 1; ++ShapeIndex)
+	{
+		Run(World, Settings, static_cast<EAutomationGraphBenchmarkShape>(ShapeEnum->GetValueByIndex(ShapeIndex)), OutReport);
+	}
+}
+
+void FAutomationGraphBenchmark::Run(UWorld* World, const FAutomationGraphBenchmarkSettings& Settings, EAutomationGraphBenchmarkShape Shape, FAutomationGraphBenchmarkReport& OutReport)
+{
+	OutReport.Timestamp = FDateTime::UtcNow();
+	OutReport.Settings = Settings;
+
+	if (!World)
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Benchmark requires a valid world."));
+		return;
+	}
+
+	// Sizes grow tenfold, so assume each one takes at least ten times as long as the last.
+	double ShapeElapsedSec = 0.0;
+	double LastSizeSec = 0.0;
+	bool bOverBudget = false;
+	for (int64 NodeCount = FMath::Max(Settings.MinNodes, 1); NodeCount <= Settings.MaxNodes; NodeCount *= 10)
+	{
+		FAutomationGraphBenchmarkResult& Result = OutReport.Results.AddDefaulted_GetRef();
+		Result.Shape = Shape;
+		Result.NodeCount = static_cast<int32>(NodeCount);
+		
+		bOverBudget |= LastSizeSec * 10.0 > Settings.ShapeBudgetSec - ShapeElapsedSec;
+		if (bOverBudget)
+		{
+			Result.bSkipped = true;
+			continue;
+		}
+
+		// Don't let the previous case's garbage skew the object counts of this one.
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		double StartTime = FPlatformTime::Seconds();
+		RunShape(World, Settings, Shape, Result.NodeCount, Result);
+		LastSizeSec = FPlatformTime::Seconds() - StartTime;
+		ShapeElapsedSec += LastSizeSec;
+
+		AG_LOG(
+			LogAutoGraphRuntime,
+			Log,
+			TEXT("%s x%d: start %.3fms, %d ticks, avg tick %.3fms, max tick %.3fms, %d objects, %lld bytes"),
+			*StaticEnum<EAutomationGraphBenchmarkShape>()->GetNameStringByValue(static_cast<int64>(Shape)),
+			Result.NodeCount,
+			Result.StartExecutionSec * 1000.0,
+			Result.TickCount,
+			Result.AvgExecuteSec * 1000.0,
+			Result.MaxExecuteSec * 1000.0,
+			Result.BuildObjectCount + Result.StartExecutionObjectCount,
+			Result.BuildMemoryBytes + Result.StartExecutionMemoryBytes
+		);
+	}
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+bool FAutomationGraphBenchmark::RunShape(UWorld* World, const FAutomationGraphBenchmarkSettings& Settings, EAutomationGraphBenchmarkShape Shape, int32 NodeCount, FAutomationGraphBenchmarkResult& OutResult)
+{
+	using namespace AutomationGraphBenchmark;
+	
+	int32 ObjectsBefore = GetObjectCount();
+	double TimeBefore = FPlatformTime::Seconds();
+
+	FSyntheticGraphBuilder Builder(Settings);
+	Builder.Build(Shape, NodeCount);
+	
+	OutResult.BuildSec = FPlatformTime::Seconds() - TimeBefore;
+	OutResult.BuildObjectCount = GetObjectCount() - ObjectsBefore;
+	OutResult.NodeCount = Builder.Nodes.Num();
+	OutResult.EdgeCount = Builder.EdgeCount;
+
+	auto* Executor = NewObject<UAutomationGraphExecutor>(GetTransientPackage(), Builder.Graph->GetExecutorType(), NAME_None, RF_Transient);
+
+	TArray<UObject*> MeasuredObjects(Builder.Nodes);
+	MeasuredObjects.Add(Builder.Graph);
+	OutResult.BuildMemoryBytes = CountMemory(MeasuredObjects);
+	
+	MeasuredObjects.Add(Executor);
+	int64 MemoryBefore = CountMemory(MeasuredObjects);
+	ObjectsBefore = GetObjectCount();
+	TimeBefore = FPlatformTime::Seconds();
+	
+	Executor->StartExecution(FGraphExecutionTask(Builder.Graph, World, EAutomationGraphNodeTrigger::OnPlay));
+	
+	OutResult.StartExecutionSec = FPlatformTime::Seconds() - TimeBefore;
+	OutResult.StartExecutionObjectCount = GetObjectCount() - ObjectsBefore;
+	OutResult.StartExecutionMemoryBytes = CountMemory(MeasuredObjects) - MemoryBefore;
+
+	bool bActive = true;
+	while (bActive && OutResult.TickCount < Settings.MaxTicks)
+	{
+		TimeBefore = FPlatformTime::Seconds();
+		bActive = Executor->Execute(Settings.DeltaSeconds);
+		double TickSec = FPlatformTime::Seconds() - TimeBefore;
+
+		OutResult.TickCount++;
+		OutResult.TotalExecuteSec += TickSec;
+		OutResult.MaxExecuteSec = FMath::Max(OutResult.MaxExecuteSec, TickSec);
+	}
+	
+	if (bActive)
+	{
+		AG_LOG(LogAutoGraphRuntime, Warning, TEXT("Benchmark graph did not finish within %d ticks."), Settings.MaxTicks);
+		Executor->Cancel(Builder.Graph);
+	}
+
+	if (OutResult.TickCount > 0)
+	{
+		OutResult.AvgExecuteSec = OutResult.TotalExecuteSec / OutResult.TickCount;
+	}
+
+	for (UAutomationGraphNode* Node : Builder.Nodes)
+	{
+		EAutomationGraphNodeState NodeState = Node->GetState();
+		if (NodeState == EAutomationGraphNodeState::Finished)
+		{
+			OutResult.FinishedNodes++;
+		}
+		else if (NodeState == EAutomationGraphNodeState::Error)
+		{
+			OutResult.FailedNodes++;
+		}
+	}
+
+	Builder.Graph->UninitializeNodes();
+	return !bActive;
+}
+
+bool FAutomationGraphBenchmark::WriteReport(const FAutomationGraphBenchmarkReport& Report, const FString& OutputFilePath)
+{
+	FString ReportString;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(Report, ReportString))
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Failed to serialize benchmark report."));
+		return false;
+	}
+
+	if (!FFileHelper::SaveStringToFile(ReportString, *OutputFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Failed to write benchmark report to %s"), *OutputFilePath);
+		return false;
+	}
+
+	return true;
+}
+
+FString FAutomationGraphBenchmark::GetDefaultReportPath(EAutomationGraphBenchmarkShape Shape)
+{
+	return FPaths::Combine(
+		FPaths::ProjectSavedDir(),
+		TEXT("AutomationGraph"),
+		TEXT("Benchmarks"),
+		FString::Printf(
+			TEXT("Benchmark_%s_%s.json"),
+			*StaticEnum<EAutomationGraphBenchmarkShape>()->GetNameStringByValue(static_cast<int64>(Shape)),
+			*FDateTime::Now().ToString()
+		)
+	);
+}
@@ -0,0 +1,148 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Benchmark/AutomationGraphBenchmark.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AutomationGraphBenchmark
+{
+	static UWorld* FindBenchmarkWorld()
+	{
+		UWorld* FallbackWorld = nullptr;
+		for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+		{
+			if (WorldContext.WorldType == EWorldType::Editor)
+			{
+				return WorldContext.World();
+			}
+
+			FallbackWorld = FallbackWorld ? FallbackWorld : WorldContext.World();
+		}
+
+		return FallbackWorld;
+	}
+
+	// Defaults can be overridden on the command line, e.g. -AGBenchmarkMaxNodes=1000 -AGBenchmarkFailureRate=0.1
+	static FAutomationGraphBenchmarkSettings GetSettingsFromCommandLine()
+	{
+		FAutomationGraphBenchmarkSettings Settings;
+		const TCHAR* CommandLine = FCommandLine::Get();
+		FParse::Value(CommandLine, TEXT("AGBenchmarkMinNodes="), Settings.MinNodes);
+		FParse::Value(CommandLine, TEXT("AGBenchmarkMaxNodes="), Settings.MaxNodes);
+		FParse::Value(CommandLine, TEXT("AGBenchmarkFailureRate="), Settings.NodeFailureRate);
+		FParse::Value(CommandLine, TEXT("AGBenchmarkNodeDurationSec="), Settings.NodeDurationSec);
+		FParse::Value(CommandLine, TEXT("AGBenchmarkSeed="), Settings.RandomSeed);
+		FParse::Value(CommandLine, TEXT("AGBenchmarkBudget="), Settings.ShapeBudgetSec);
+		return Settings;
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(
+	FAutomationGraphBenchmarkTest,
+	"AutomationGraph.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter
+)
+
+void FAutomationGraphBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	UEnum* ShapeEnum = StaticEnum<EAutomationGraphBenchmarkShape>();
+	for (int32 ShapeIndex = 0; ShapeIndex < ShapeEnum->NumEnums() - 1; ++ShapeIndex)
+	{
+		OutBeautifiedNames.Add(ShapeEnum->GetNameStringByIndex(ShapeIndex));
+		OutTestCommands.Add(ShapeEnum->GetNameStringByIndex(ShapeIndex));
+	}
+}
+
+bool FAutomationGraphBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace AutomationGraphBenchmark;
+
+	int64 ShapeValue = StaticEnum<EAutomationGraphBenchmarkShape>()->GetValueByNameString(Parameters);
+	if (ShapeValue == INDEX_NONE)
+	{
+		AddError(FString::Printf(TEXT("Unknown benchmark shape: %s"), *Parameters));
+		return false;
+	}
+
+	UWorld* World = FindBenchmarkWorld();
+	if (!World)
+	{
+		AddError(TEXT("Benchmark requires a valid world."));
+		return false;
+	}
+
+	auto Shape = static_cast<EAutomationGraphBenchmarkShape>(ShapeValue);
+	FAutomationGraphBenchmarkReport Report;
+	FAutomationGraphBenchmark::Run(World, GetSettingsFromCommandLine(), Shape, Report);
+
+	for (const FAutomationGraphBenchmarkResult& Result : Report.Results)
+	{
+		if (Result.bSkipped)
+		{
+			AddInfo(FString::Printf(TEXT("x%d: skipped, the shape went over its time budget."), Result.NodeCount));
+			continue;
+		}
+
+		if (Result.FinishedNodes + Result.FailedNodes != Result.NodeCount)
+		{
+			AddError(FString::Printf(TEXT("x%d: graph did not finish within %d ticks."), Result.NodeCount, Report.Settings.MaxTicks));
+		}
+
+		AddInfo(FString::Printf(
+			TEXT("x%d: start %.3fms, %d ticks, avg tick %.3fms, max tick %.3fms, %d objects, %lld bytes"),
+			Result.NodeCount,
+			Result.StartExecutionSec * 1000.0,
+			Result.TickCount,
+			Result.AvgExecuteSec * 1000.0,
+			Result.MaxExecuteSec * 1000.0,
+			Result.BuildObjectCount + Result.StartExecutionObjectCount,
+			Result.BuildMemoryBytes + Result.StartExecutionMemoryBytes
+		));
+	}
+
+	FString OutputFilePath = FAutomationGraphBenchmark::GetDefaultReportPath(Shape);
+	if (!FAutomationGraphBenchmark::WriteReport(Report, OutputFilePath))
+	{
+		AddError(FString::Printf(TEXT("Failed to write benchmark report to %s"), *OutputFilePath));
+		return false;
+	}
+
+	AddInfo(FString::Printf(TEXT("Wrote benchmark report to %s"), *OutputFilePath));
+	return true;
+}
+
+#endif
@@ -31,8 +31,12 @@
 
 #include "Foundation/AutomationGraph.h"
 
+#include "AutomationGraphRuntimeLoggingDefs.h"
 #include "AutomationNodes/ClearLandscapeLayers.h"
+#include "EdGraph/EdGraph.h"
 #include "Foundation/AutomationGraphExecutor.h"
+#include "Foundation/AutomationGraphStructNode.h"
+#include "Macros/AutomationGraphLoggingMacros.h"
 
 #define LOCTEXT_NAMESPACE "AutomationGraph"
 
@@ -90,4 +94,120 @@ void UAutomationGraph::CancelNodes()
 	}
 }
 
+bool UAutomationGraph::HasRootTrigger(EAutomationGraphNodeTrigger Trigger)
+{
+	for (UAutomationGraphNode* RootNode : RootNodes)
+	{
+		if (RootNode && RootNode->GetTriggers().Contains(Trigger))
+		{
+			return true;
+		}
+	}
+
+	if (StructNodes.IsEmpty())
+	{
+		return false;
+	}
+
+	TBitArray<> HasParent(false, StructNodes.Num());
+	for (const FAutomationGraphEdge& Edge : StructEdges)
+	{
+		if (HasParent.IsValidIndex(Edge.ChildIndex))
+		{
+			HasParent[Edge.ChildIndex] = true;
+		}
+	}
+	
+	for (int32 NodeIndex = 0; NodeIndex < StructNodes.Num(); ++NodeIndex)
+	{
+		const FAutomationGraphStructNode* StructNode = StructNodes[NodeIndex].GetPtr<FAutomationGraphStructNode>();
+		if (StructNode && !HasParent[NodeIndex] && StructNode->HasTrigger(Trigger))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#if WITH_EDITOR
+void UAutomationGraph::PostLoad()
+{
+	Super::PostLoad();
+
+#if WITH_EDITORONLY_DATA
+	// Older assets saved the editor graph with the asset. Keep it for this session (the editor reads node positions
+	// from it), but don't write it out again.
+	if (EditorGraph)
+	{
+		EditorGraph->SetFlags(RF_Transient);
+	}
+#endif
+
+	// Older assets could also have nodes outered to an editor node (pasted nodes were left inside the editor node
+	// they were copied into). Move them back under the graph so they survive the editor graph not being saved.
+	TArray<UAutomationGraphNode*> NodeStack(RootNodes);
+	TSet<UAutomationGraphNode*> Visited;
+
+	while (!NodeStack.IsEmpty())
+	{
+		UAutomationGraphNode* AutomationNode = NodeStack.Pop();
+		if (!AutomationNode || Visited.Contains(AutomationNode))
+		{
+			continue;
+		}
+
+		Visited.Add(AutomationNode);
+		if (AutomationNode->GetOuter() != this)
+		{
+			AutomationNode->Rename(nullptr, this, REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional | REN_ForceNoResetLoaders);
+		}
+		NodeStack.Append(AutomationNode->ChildNodes);
+	}
+}
+#endif
+
+UAutomationGraphNode* UAutomationGraph::FindNode(const FString& NodeName) const
+{
+	TArray<UAutomationGraphNode*> NodeStack(RootNodes);
+	TSet<UAutomationGraphNode*> Visited;
+	TArray<UAutomationGraphNode*> TitleMatches;
+
+	while (!NodeStack.IsEmpty())
+	{
+		UAutomationGraphNode* AutomationNode = NodeStack.Pop();
+		if (!AutomationNode || Visited.Contains(AutomationNode))
+		{
+			continue;
+		}
+
+		// Object names are unique within the graph, so they always identify a single node.
+		Visited.Add(AutomationNode);
+		if (AutomationNode->GetName() == NodeName)
+		{
+			return AutomationNode;
+		}
+		
+		if (AutomationNode->Title.ToString() == NodeName)
+		{
+			TitleMatches.Add(AutomationNode);
+		}
+		NodeStack.Append(AutomationNode->ChildNodes);
+	}
+
+	if (TitleMatches.Num() > 1)
+	{
+		TArray<FString> MatchNames;
+		for (const UAutomationGraphNode* TitleMatch : TitleMatches)
+		{
+			MatchNames.Add(TitleMatch->GetName());
+		}
+		
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("More than one node is titled %s (%s). Use the object name of the node instead."), *NodeName, *FString::Join(MatchNames, TEXT(", ")));
+		return nullptr;
+	}
+
+	return TitleMatches.IsEmpty() ? nullptr : TitleMatches[0];
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,135 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Foundation/AutomationGraphAdjacency.h"
+
+#include "AutomationGraphRuntimeLoggingDefs.h"
+#include "Macros/AutomationGraphLoggingMacros.h"
+
+bool FAutomationGraphAdjacency::Build(int32 NodeCount, TConstArrayView<FAutomationGraphEdge> Edges, FString& OutError)
+{
+	Reset();
+	
+	TArray<int32> OutDegree;
+	OutDegree.SetNumZeroed(NodeCount);
+	ParentCounts.SetNumZeroed(NodeCount);
+	
+	TSet<uint64> SeenEdges;
+	SeenEdges.Reserve(Edges.Num());
+	TArray<FAutomationGraphEdge> UniqueEdges;
+	UniqueEdges.Reserve(Edges.Num());
+	
+	for (const FAutomationGraphEdge& Edge : Edges)
+	{
+		if (!ParentCounts.IsValidIndex(Edge.ParentIndex) || !ParentCounts.IsValidIndex(Edge.ChildIndex))
+		{
+			OutError = FString::Printf(TEXT("Edge %d -> %d references a node that does not exist."), Edge.ParentIndex, Edge.ChildIndex);
+			Reset();
+			return false;
+		}
+		if (Edge.ParentIndex == Edge.ChildIndex)
+		{
+			OutError = FString::Printf(TEXT("Edge %d -> %d connects a node to itself."), Edge.ParentIndex, Edge.ChildIndex);
+			Reset();
+			return false;
+		}
+
+		uint64 EdgeKey = (static_cast<uint64>(Edge.ParentIndex) << 32) | static_cast<uint32>(Edge.ChildIndex);
+		bool bAlreadyInSet = false;
+		SeenEdges.Add(EdgeKey, &bAlreadyInSet);
+		if (bAlreadyInSet)
+		{
+			AG_LOG(LogAutoGraphRuntime, Warning, TEXT("Skipping duplicate edge %d -> %d"), Edge.ParentIndex, Edge.ChildIndex);
+			continue;
+		}
+		
+		UniqueEdges.Add(Edge);
+		OutDegree[Edge.ParentIndex]++;
+		ParentCounts[Edge.ChildIndex]++;
+	}
+
+	ChildOffsets.SetNumUninitialized(NodeCount + 1);
+	ChildOffsets[0] = 0;
+	for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
+	{
+		ChildOffsets[NodeIndex + 1] = ChildOffsets[NodeIndex] + OutDegree[NodeIndex];
+	}
+
+	Children.SetNumUninitialized(UniqueEdges.Num());
+	TArray<int32> InsertOffsets(ChildOffsets.GetData(), NodeCount);
+	for (const FAutomationGraphEdge& Edge : UniqueEdges)
+	{
+		Children[InsertOffsets[Edge.ParentIndex]++] = Edge.ChildIndex;
+	}
+
+	// Kahn's algorithm. If we can't visit every node, the remaining ones are part of a cycle.
+	TArray<int32> RemainingParents = ParentCounts;
+	TArray<int32> ReadyNodes;
+	ReadyNodes.Reserve(NodeCount);
+	for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
+	{
+		if (RemainingParents[NodeIndex] == 0)
+		{
+			ReadyNodes.Add(NodeIndex);
+		}
+	}
+
+	int32 VisitedCount = 0;
+	while (!ReadyNodes.IsEmpty())
+	{
+		int32 NodeIndex = ReadyNodes.Pop(EAllowShrinking::No);
+		VisitedCount++;
+		
+		for (int32 ChildIndex : GetChildren(NodeIndex))
+		{
+			if (--RemainingParents[ChildIndex] == 0)
+			{
+				ReadyNodes.Add(ChildIndex);
+			}
+		}
+	}
+
+	if (VisitedCount != NodeCount)
+	{
+		OutError = FString::Printf(TEXT("The graph contains a cycle (%d of %d nodes are unreachable in topological order)."), NodeCount - VisitedCount, NodeCount);
+		Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void FAutomationGraphAdjacency::Reset()
+{
+	ChildOffsets.Reset();
+	Children.Reset();
+	ParentCounts.Reset();
+}
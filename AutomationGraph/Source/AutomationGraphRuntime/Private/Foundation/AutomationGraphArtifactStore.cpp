@@ -0,0 +1,245 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Foundation/AutomationGraphArtifactStore.h"
+
+#include "AutomationGraphRuntimeLoggingDefs.h"
+#include "Async/MappedFileHandle.h"
+#include "Foundation/AutomationGraphHistory.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Macros/AutomationGraphLoggingMacros.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+FAutomationGraphArtifactView::~FAutomationGraphArtifactView()
+{
+	// The region has to be released before the file handle.
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+FString FAutomationGraphArtifactStore::GetStoreDirectory(const FString& GraphPath)
+{
+	// Use the same naming as the history store so the two are easy to match up.
+	FString StoreName = FPaths::GetBaseFilename(FAutomationGraphHistory::GetHistoryFilePath(GraphPath));
+
+	// Graphs that live inside another object (subgraph instances) get their own directory, so they don't clear out the
+	// artifacts of the graph that contains them.
+	int32 SubObjectIndex = INDEX_NONE;
+	if (GraphPath.FindChar(SUBOBJECT_DELIMITER_CHAR, SubObjectIndex))
+	{
+		StoreName += TEXT(".") + FPaths::MakeValidFileName(GraphPath.RightChop(SubObjectIndex + 1));
+	}
+	
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AutomationGraph"), TEXT("Artifacts"), StoreName);
+}
+
+void FAutomationGraphArtifactStore::BeginRun(const FString& GraphPath, bool bKeepArtifacts)
+{
+	FString NewStoreDirectory = GetStoreDirectory(GraphPath);
+	if (NewStoreDirectory != StoreDirectory)
+	{
+		Artifacts.Empty();
+		StoreDirectory = MoveTemp(NewStoreDirectory);
+	}
+
+	if (!bKeepArtifacts)
+	{
+		DeleteStoreDirectory();
+	}
+}
+
+void FAutomationGraphArtifactStore::EndRun(EAutomationGraphArtifactRetention Retention, bool bRunSucceeded)
+{
+	bool bDelete = Retention == EAutomationGraphArtifactRetention::DeleteWhenRunEnds
+		|| (Retention == EAutomationGraphArtifactRetention::KeepIfFailed && bRunSucceeded);
+	
+	if (bDelete)
+	{
+		DeleteStoreDirectory();
+	}
+	else if (!Artifacts.IsEmpty())
+	{
+		AG_LOG(LogAutoGraphRuntime, Log, TEXT("Kept %d artifacts in %s"), Artifacts.Num(), *StoreDirectory);
+	}
+}
+
+void FAutomationGraphArtifactStore::Reset()
+{
+	StoreDirectory.Empty();
+	Artifacts.Empty();
+}
+
+bool FAutomationGraphArtifactStore::PublishArtifact(const UAutomationGraphNode* Producer, FName Name, TConstArrayView64<uint8> Data)
+{
+	FString FilePath;
+	if (!AddArtifact(Producer, Name, FilePath))
+	{
+		return false;
+	}
+	
+	if (!FFileHelper::SaveArrayToFile(Data, *FilePath))
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Failed to write artifact %s to %s"), *Name.ToString(), *FilePath);
+		Artifacts.Remove(Name);
+		return false;
+	}
+
+	return true;
+}
+
+bool FAutomationGraphArtifactStore::PublishArtifactFile(const UAutomationGraphNode* Producer, FName Name, const FString& SourceFilePath)
+{
+	FString FilePath;
+	if (!AddArtifact(Producer, Name, FilePath))
+	{
+		return false;
+	}
+
+	if (!IFileManager::Get().Move(*FilePath, *SourceFilePath))
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Failed to move %s into the artifact store"), *SourceFilePath);
+		Artifacts.Remove(Name);
+		return false;
+	}
+
+	return true;
+}
+
+TSharedPtr<FAutomationGraphArtifactView> FAutomationGraphArtifactStore::MapArtifact(FName Name) const
+{
+	const FArtifact* Artifact = Artifacts.Find(Name);
+	if (!Artifact)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FAutomationGraphArtifactView> View = MakeShared<FAutomationGraphArtifactView>();
+	
+	View->MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Artifact->FilePath));
+	if (!View->MappedFile)
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Failed to map artifact %s"), *Artifact->FilePath);
+		return nullptr;
+	}
+
+	// Empty files can't be mapped, but are still valid artifacts.
+	const int64 FileSize = View->MappedFile->GetFileSize();
+	if (FileSize > 0)
+	{
+		View->MappedRegion.Reset(View->MappedFile->MapRegion(0, FileSize));
+		if (!View->MappedRegion)
+		{
+			AG_LOG(LogAutoGraphRuntime, Error, TEXT("Failed to map artifact %s"), *Artifact->FilePath);
+			return nullptr;
+		}
+		View->Data = TConstArrayView64<uint8>(View->MappedRegion->GetMappedPtr(), View->MappedRegion->GetMappedSize());
+	}
+	
+	return View;
+}
+
+FString FAutomationGraphArtifactStore::GetArtifactFilePath(FName Name) const
+{
+	const FArtifact* Artifact = Artifacts.Find(Name);
+	return Artifact ? Artifact->FilePath : FString();
+}
+
+void FAutomationGraphArtifactStore::GetArtifacts(const UAutomationGraphNode* Producer, TArray<FName>& OutNames) const
+{
+	const TObjectKey<UAutomationGraphNode> ProducerKey(Producer);
+	for (const TPair<FName, FArtifact>& Artifact : Artifacts)
+	{
+		if (Artifact.Value.Producer == ProducerKey)
+		{
+			OutNames.Add(Artifact.Key);
+		}
+	}
+}
+
+void FAutomationGraphArtifactStore::RemoveArtifacts(const UAutomationGraphNode* Producer)
+{
+	const TObjectKey<UAutomationGraphNode> ProducerKey(Producer);
+	for (auto It = Artifacts.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Producer == ProducerKey)
+		{
+			IFileManager::Get().Delete(*It->Value.FilePath, false, true, true);
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool FAutomationGraphArtifactStore::AddArtifact(const UAutomationGraphNode* Producer, FName Name, FString& OutFilePath)
+{
+	if (StoreDirectory.IsEmpty())
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Can't publish artifact %s: no run is in progress."), *Name.ToString());
+		return false;
+	}
+	if (const FArtifact* ExistingArtifact = Artifacts.Find(Name))
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Can't publish artifact %s from %s: it was already published by %s."),
+			*Name.ToString(), *GetNameSafe(Producer), *GetNameSafe(ExistingArtifact->Producer.ResolveObjectPtr()));
+		return false;
+	}
+
+	// Names are made file-safe, so two different names can map to the same file name. Keeping each producer's files in
+	// their own directory means that can only happen within a single node.
+	OutFilePath = FPaths::Combine(StoreDirectory, FPaths::MakeValidFileName(GetNameSafe(Producer)), FPaths::MakeValidFileName(Name.ToString()));
+	for (const TPair<FName, FArtifact>& Artifact : Artifacts)
+	{
+		if (Artifact.Value.FilePath == OutFilePath)
+		{
+			AG_LOG(LogAutoGraphRuntime, Error, TEXT("Can't publish artifact %s from %s: %s has the same file name."), *Name.ToString(), *GetNameSafe(Producer), *Artifact.Key.ToString());
+			return false;
+		}
+	}
+	
+	Artifacts.Add(Name, FArtifact(Producer, OutFilePath));
+	return true;
+}
+
+void FAutomationGraphArtifactStore::DeleteStoreDirectory()
+{
+	Artifacts.Empty();
+	if (StoreDirectory.IsEmpty() || !IFileManager::Get().DirectoryExists(*StoreDirectory))
+	{
+		return;
+	}
+	
+	// This fails if a consumer is still holding a view of one of the artifacts.
+	if (!IFileManager::Get().DeleteDirectory(*StoreDirectory, false, true))
+	{
+		AG_LOG(LogAutoGraphRuntime, Warning, TEXT("Failed to delete artifacts in %s. Are they still mapped?"), *StoreDirectory);
+	}
+}
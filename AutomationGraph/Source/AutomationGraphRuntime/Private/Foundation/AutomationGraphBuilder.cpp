@@ -0,0 +1,198 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Foundation/AutomationGraphBuilder.h"
+
+#include "Foundation/AutomationGraphAdjacency.h"
+#include "Foundation/AutomationGraphNode.h"
+
+#if WITH_EDITOR
+FAutomationGraphBuilder::FOnGraphRebuilding FAutomationGraphBuilder::OnGraphRebuilding;
+#endif
+
+FAutomationGraphBuilder::FAutomationGraphBuilder(UAutomationGraph* InGraph): Graph(InGraph)
+{
+	check(Graph);
+}
+
+void FAutomationGraphBuilder::Reserve(int32 NumNodes, int32 NumEdges)
+{
+	Nodes.Reserve(NumNodes);
+	Edges.Reserve(NumEdges);
+}
+
+int32 FAutomationGraphBuilder::AddNode(UAutomationGraphNode* Node)
+{
+	return Nodes.Add(Node);
+}
+
+UAutomationGraphNode* FAutomationGraphBuilder::CreateNode(TSubclassOf<UAutomationGraphNode> NodeClass, int32* OutNodeIndex)
+{
+	UAutomationGraphNode* Node = nullptr;
+	if (NodeClass && !NodeClass->HasAnyClassFlags(CLASS_Abstract))
+	{
+		Node = NewObject<UAutomationGraphNode>(Graph, NodeClass, NAME_None, RF_Transactional);
+	}
+
+	// Invalid nodes are still added so that indices stay stable. Build() reports the error.
+	int32 NodeIndex = AddNode(Node);
+	if (OutNodeIndex)
+	{
+		*OutNodeIndex = NodeIndex;
+	}
+	return Node;
+}
+
+void FAutomationGraphBuilder::AddEdge(int32 ParentIndex, int32 ChildIndex)
+{
+	Edges.Emplace(ParentIndex, ChildIndex);
+}
+
+void FAutomationGraphBuilder::AddEdges(TConstArrayView<FAutomationGraphEdge> NewEdges)
+{
+	Edges.Append(NewEdges.GetData(), NewEdges.Num());
+}
+
+void FAutomationGraphBuilder::AddStructEdge(int32 ParentIndex, int32 ChildIndex)
+{
+	StructEdges.Emplace(ParentIndex, ChildIndex);
+}
+
+void FAutomationGraphBuilder::AddStructEdges(TConstArrayView<FAutomationGraphEdge> NewEdges)
+{
+	StructEdges.Append(NewEdges.GetData(), NewEdges.Num());
+}
+
+bool FAutomationGraphBuilder::Build(FString& OutError)
+{
+	const int32 NodeCount = Nodes.Num();
+
+	TSet<UAutomationGraphNode*> UniqueNodes;
+	UniqueNodes.Reserve(NodeCount);
+	for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
+	{
+		UAutomationGraphNode* Node = Nodes[NodeIndex];
+		if (!Node)
+		{
+			OutError = FString::Printf(TEXT("Node %d is invalid."), NodeIndex);
+			return false;
+		}
+
+		bool bAlreadyInSet = false;
+		UniqueNodes.Add(Node, &bAlreadyInSet);
+		if (bAlreadyInSet)
+		{
+			OutError = FString::Printf(TEXT("Node %d (%s) was added more than once."), NodeIndex, *Node->GetName());
+			return false;
+		}
+		if (!Graph->IsNodeSupported(Node->GetClass()))
+		{
+			OutError = FString::Printf(TEXT("Node %d (%s) is not supported by this graph."), NodeIndex, *Node->GetClass()->GetName());
+			return false;
+		}
+		if (Node->GetOuter() != Graph)
+		{
+			OutError = FString::Printf(TEXT("Node %d (%s) is not owned by this graph."), NodeIndex, *Node->GetName());
+			return false;
+		}
+	}
+
+	for (int32 NodeIndex = 0; NodeIndex < StructNodes.Num(); ++NodeIndex)
+	{
+		if (!StructNodes[NodeIndex].GetPtr<FAutomationGraphStructNode>())
+		{
+			OutError = FString::Printf(TEXT("Struct node %d is invalid."), NodeIndex);
+			return false;
+		}
+	}
+
+	FAutomationGraphAdjacency Adjacency;
+	if (!Adjacency.Build(NodeCount, Edges, OutError))
+	{
+		return false;
+	}
+
+	// Struct edges are validated here too, so the graph is never left with a struct graph the executor will reject.
+	FAutomationGraphAdjacency StructAdjacency;
+	if (!StructAdjacency.Build(StructNodes.Num(), StructEdges, OutError))
+	{
+		OutError = TEXT("Struct nodes: ") + OutError;
+		return false;
+	}
+
+#if WITH_EDITOR
+	OnGraphRebuilding.Broadcast(Graph);
+#endif
+
+	// Everything is valid, commit to the graph.
+	for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
+	{
+		Nodes[NodeIndex]->ParentNodes.Reset(Adjacency.ParentCounts[NodeIndex]);
+		Nodes[NodeIndex]->ChildNodes.Reset(Adjacency.GetChildren(NodeIndex).Num());
+	}
+	for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
+	{
+		for (int32 ChildIndex : Adjacency.GetChildren(NodeIndex))
+		{
+			Nodes[NodeIndex]->ChildNodes.Add(Nodes[ChildIndex]);
+			Nodes[ChildIndex]->ParentNodes.Add(Nodes[NodeIndex]);
+		}
+	}
+
+	Graph->RootNodes.Reset();
+	for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
+	{
+		if (Adjacency.ParentCounts[NodeIndex] == 0)
+		{
+			Graph->RootNodes.Add(Nodes[NodeIndex]);
+		}
+	}
+
+	// Store the deduplicated struct edges. The staged struct nodes are copied rather than moved so that the builder
+	// still describes the whole graph, like it does for object nodes.
+	Graph->StructNodes = StructNodes;
+	Graph->StructEdges.Reset(StructAdjacency.Children.Num());
+	for (int32 NodeIndex = 0; NodeIndex < StructAdjacency.NumNodes(); ++NodeIndex)
+	{
+		for (int32 ChildIndex : StructAdjacency.GetChildren(NodeIndex))
+		{
+			Graph->StructEdges.Emplace(NodeIndex, ChildIndex);
+		}
+	}
+
+#if WITH_EDITORONLY_DATA
+	// The editor graph no longer matches the runtime nodes. It will be regenerated when the asset is opened.
+	Graph->EditorGraph = nullptr;
+	Graph->EditorNodePositions.Reset();
+#endif
+	
+	return true;
+}
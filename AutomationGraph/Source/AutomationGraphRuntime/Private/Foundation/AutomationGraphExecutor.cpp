@@ -33,10 +33,20 @@
 
 #include "AutomationGraphRuntimeLoggingDefs.h"
 #include "Foundation/AutomationGraph.h"
+#include "Foundation/AutomationGraphStructNode.h"
+#include "HAL/IConsoleManager.h"
 #include "Macros/AutomationGraphLoggingMacros.h"
 
+static TAutoConsoleVariable<bool> CVarIgnoreResultCache(
+	TEXT("AutomationGraph.IgnoreResultCache"),
+	false,
+	TEXT("If true, every node runs even if its result is cached. Successful runs still update the cache.")
+);
+
 void UAutomationGraphExecutor::StartExecution(FGraphExecutionTask ExecutionTask)
 {
+	bLastRunSucceeded = false;
+	
 	if (!ExecutionTask.TargetGraph.IsValid())
 	{
 		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Tried to execute an invalid graph. Skipping execution."));
@@ -53,8 +63,21 @@ void UAutomationGraphExecutor::StartExecution(FGraphExecutionTask ExecutionTask)
 		return;
 	}
 
+	// Partial runs of the same graph keep the outputs and artifacts of the nodes that aren't re-run.
+	const bool bKeepPreviousResults = !ExecutionTask.DirtyNodes.IsEmpty() && TargetGraph == ExecutionTask.TargetGraph;
+	FAutomationGraphResultTable PreviousResults;
+	FAutomationGraphArtifactStore PreviousArtifacts;
+	if (bKeepPreviousResults)
+	{
+		PreviousResults = MoveTemp(ResultTable);
+		PreviousArtifacts = MoveTemp(ArtifactStore);
+	}
+
 	Reset();
 	TargetGraph = ExecutionTask.TargetGraph;
+	ResultTable = MoveTemp(PreviousResults);
+	ArtifactStore = MoveTemp(PreviousArtifacts);
+	ArtifactStore.BeginRun(TargetGraph->GetPathName(), bKeepPreviousResults);
 	PreInitializeNodes(ExecutionTask.TargetWorld.Get());
 
 	struct CycleCheckNode
@@ -63,10 +86,22 @@ void UAutomationGraphExecutor::StartExecution(FGraphExecutionTask ExecutionTask)
 		TSet<UAutomationGraphNode*> Ancestors;
 	};
 
+	// For partial runs, nodes that didn't finish last time can't reuse their result, so they are treated as dirty too.
+	const bool bPartialRun = !ExecutionTask.DirtyNodes.IsEmpty();
+	TSet<UAutomationGraphNode*> DirtyNodes;
+	for (TWeakObjectPtr<UAutomationGraphNode> WeakDirtyNode : ExecutionTask.DirtyNodes)
+	{
+		if (UAutomationGraphNode* DirtyNode = WeakDirtyNode.Get())
+		{
+			DirtyNodes.Add(DirtyNode);
+		}
+	}
+
 	TArray<CycleCheckNode> NodeStack;
 	for (UAutomationGraphNode* Node : TargetGraph->RootNodes)
 	{
-		if (Node->GetTriggers().Contains(ExecutionTask.Trigger))
+		const TArray<EAutomationGraphNodeTrigger> NodeTriggers = Node->GetTriggers();
+		if (NodeTriggers.ContainsByPredicate([&ExecutionTask](EAutomationGraphNodeTrigger NodeTrigger) { return ExecutionTask.HasTrigger(NodeTrigger); }))
 		{
 			ActiveNodes.Add(Node);
 			NodeStack.Add(CycleCheckNode(Node, TSet<UAutomationGraphNode*>()));
@@ -85,7 +120,15 @@ void UAutomationGraphExecutor::StartExecution(FGraphExecutionTask ExecutionTask)
 			continue;
 		}
 
+		if (bPartialRun && GraphNode->GetState() != EAutomationGraphNodeState::Finished)
+		{
+			DirtyNodes.Add(GraphNode);
+		}
+
+		GraphNode->SetResultTable(&ResultTable);
+		GraphNode->SetArtifactStore(&ArtifactStore);
 		InitializeNode(GraphNode, ExecutionTask.TargetWorld.Get());
+		ExecutionNodes.Add(GraphNode);
 		Visited.Add(GraphNode);
 		Ancestors.Add(GraphNode);
 		
@@ -103,11 +146,51 @@ void UAutomationGraphExecutor::StartExecution(FGraphExecutionTask ExecutionTask)
 	}
 
 	PostInitializeNodes();
+
+	if (!ValidateDataSlots())
+	{
+		Reset();
+		return;
+	}
+
+	if (bPartialRun)
+	{
+		// Struct nodes can't be marked dirty, so they keep their previous results as well.
+		if (!ApplyDirtySubgraph(DirtyNodes))
+		{
+			AG_LOG_OBJECT(this, LogAutoGraphRuntime, Log, TEXT("No dirty nodes are reachable from the trigger. Skipping execution."));
+			Reset();
+			return;
+		}
+	}
+	else if (!StartStructExecution(ExecutionTask))
+	{
+		Reset();
+		return;
+	}
+
+	CurrentRunRecord = FAutomationGraphRunRecord();
+	CurrentRunRecord.GraphPath = TargetGraph->GetPathName();
+	CurrentRunRecord.Trigger = ExecutionTask.Trigger;
+	CurrentRunRecord.StartTime = FDateTime::UtcNow();
+	bRecordingRun = TargetGraph->bRecordExecutionHistory && (!ActiveNodes.IsEmpty() || !ActiveStructNodes.IsEmpty());
+
+	bUseResultCache = TargetGraph->bUseResultCache;
+	if (bUseResultCache)
+	{
+		ResultCache.Load(TargetGraph->GetPathName());
+	}
+
+	// Nothing responds to this trigger, which counts as a successful (empty) run.
+	if (!IsRunning())
+	{
+		EndRun(true);
+	}
 }
 
 bool UAutomationGraphExecutor::Execute(float DeltaSeconds)
 {
-	if (ActiveNodes.IsEmpty())
+	if (ActiveNodes.IsEmpty() && ActiveStructNodes.IsEmpty())
 	{
 		return false;
 	}
@@ -118,6 +201,18 @@ bool UAutomationGraphExecutor::Execute(float DeltaSeconds)
 		return true;
 	}
 	ExecutionTimer = TickRateSec;
+
+	if (!ActiveStructNodes.IsEmpty())
+	{
+		if (!TargetGraph.IsValid())
+		{
+			AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Target graph became invalid. Resetting executor."));
+			Reset();
+			return false;
+		}
+		
+		ExecuteStructNodes(DeltaSeconds);
+	}
 	
 	TSet<TWeakObjectPtr<UAutomationGraphNode>> ToAdd;
 	TSet<TWeakObjectPtr<UAutomationGraphNode>> ToRemove;
@@ -138,6 +233,10 @@ bool UAutomationGraphExecutor::Execute(float DeltaSeconds)
 		{
 		case EAutomationGraphNodeState::Standby:
 		case EAutomationGraphNodeState::Active:
+			if (NodeState == EAutomationGraphNodeState::Standby && TryFinishFromCache(CurrentNode))
+			{
+				continue;
+			}
 			if (CurrentNode->CanActivate())
 			{
 				CurrentNode->Activate(DeltaSeconds);
@@ -145,11 +244,15 @@ bool UAutomationGraphExecutor::Execute(float DeltaSeconds)
 			
 			continue;
 		case EAutomationGraphNodeState::Finished:
+			UpdateResultCache(CurrentNode);
 			for (UAutomationGraphNode* ChildNode : CurrentNode->ChildNodes)
 			{
 				if (ChildNode->CanStartActivation())
 				{
-					ChildNode->Activate(DeltaSeconds);
+					if (!TryFinishFromCache(ChildNode))
+					{
+						ChildNode->Activate(DeltaSeconds);
+					}
 					ToAdd.Add(ChildNode);
 				}
 			}
@@ -159,6 +262,7 @@ bool UAutomationGraphExecutor::Execute(float DeltaSeconds)
 		case EAutomationGraphNodeState::Expired:
 		case EAutomationGraphNodeState::Cancelled:
 		case EAutomationGraphNodeState::Error:
+			UpdateResultCache(CurrentNode);
 			ToRemove.Add(CurrentNode);
 			continue;
 		default:
@@ -178,7 +282,30 @@ bool UAutomationGraphExecutor::Execute(float DeltaSeconds)
 		ActiveNodes.Remove(RemoveNode);
 	}
 	
-	bool bExecutionFinished = ActiveNodes.IsEmpty();
+	bool bExecutionFinished = ActiveNodes.IsEmpty() && ActiveStructNodes.IsEmpty();
+	if (bExecutionFinished)
+	{
+		bool bRunSucceeded = true;
+		for (TWeakObjectPtr<UAutomationGraphNode> WeakNode : ExecutionNodes)
+		{
+			if (WeakNode.IsValid() && WeakNode->GetState() != EAutomationGraphNodeState::Finished)
+			{
+				bRunSucceeded = false;
+				break;
+			}
+		}
+		for (EAutomationGraphNodeState StructNodeState : StructNodeStates)
+		{
+			if (StructNodeState != EAutomationGraphNodeState::Uninitialized && StructNodeState != EAutomationGraphNodeState::Finished)
+			{
+				bRunSucceeded = false;
+				break;
+			}
+		}
+		
+		EndRun(bRunSucceeded);
+	}
+	
 	return !bExecutionFinished;
 }
 
@@ -188,7 +315,19 @@ void UAutomationGraphExecutor::Cancel(UAutomationGraph* Graph)
 	if (CurrentGraph && Graph == CurrentGraph)
 	{
 		CurrentGraph->CancelNodes();
+		CancelStructNodes();
+
+		// A cancelled node may have partially written its outputs, so its previous result can no longer be trusted.
+		for (TWeakObjectPtr<UAutomationGraphNode> WeakNode : ActiveNodes)
+		{
+			if (UAutomationGraphNode* Node = WeakNode.Get())
+			{
+				UpdateResultCache(Node);
+			}
+		}
+		
 		ActiveNodes.Empty();
+		EndRun(false);
 	}
 }
 
@@ -203,8 +342,579 @@ void UAutomationGraphExecutor::Reset()
 	if (CurrentGraph)
 	{
 		CurrentGraph->CancelNodes();
+		CancelStructNodes();
 	}
 	TargetGraph = nullptr;
 	ActiveNodes.Empty();
+	ExecutionNodes.Empty();
+	
+	StructNodes.Empty();
+	StructAdjacency.Reset();
+	StructNodeStates.Empty();
+	StructNodeElapsedSec.Empty();
+	StructNodeRemainingParents.Empty();
+	ActiveStructNodes.Empty();
+	StructNodeStartTimes.Empty();
+	StructNodeEndTimes.Empty();
+	bRecordingRun = false;
+
+	bUseResultCache = false;
+	ResultCache.Reset();
+	NodeCacheKeys.Empty();
+	NodeResultKeys.Empty();
+	ForcedNodes.Empty();
+	ResultTable.Reset();
+	ArtifactStore.Reset();
+	
 	ExecutionTimer = 0.0f;
 }
+
+void UAutomationGraphExecutor::EndRun(bool bRunSucceeded)
+{
+	bLastRunSucceeded = bRunSucceeded;
+	RecordExecutionHistory();
+	ResultCache.Save();
+
+	if (UAutomationGraph* Graph = TargetGraph.Get())
+	{
+		ArtifactStore.EndRun(Graph->ArtifactRetention, bRunSucceeded);
+	}
+}
+
+void UAutomationGraphExecutor::RecordExecutionHistory()
+{
+	if (!bRecordingRun)
+	{
+		return;
+	}
+	bRecordingRun = false;
+
+	CurrentRunRecord.EndTime = FDateTime::UtcNow();
+	CurrentRunRecord.Nodes.Reset(ExecutionNodes.Num());
+	
+	for (TWeakObjectPtr<UAutomationGraphNode> WeakNode : ExecutionNodes)
+	{
+		UAutomationGraphNode* Node = WeakNode.Get();
+		if (!Node)
+		{
+			continue;
+		}
+
+		FAutomationGraphNodeRunRecord& NodeRecord = CurrentRunRecord.Nodes.AddDefaulted_GetRef();
+		NodeRecord.NodeName = Node->GetName();
+		NodeRecord.NodeClass = Node->GetClass()->GetName();
+		NodeRecord.Title = Node->Title.ToString();
+		NodeRecord.State = Node->GetState();
+		NodeRecord.bCached = Node->IsFinishedFromCache();
+		NodeRecord.bReused = Node->IsReusingPreviousResult();
+
+		FDateTime ActivationStartTime = Node->GetActivationStartTime();
+		FDateTime ActivationEndTime = Node->GetActivationEndTime();
+		if (ActivationStartTime.GetTicks() > 0)
+		{
+			NodeRecord.StartOffsetSec = (ActivationStartTime - CurrentRunRecord.StartTime).GetTotalSeconds();
+			if (ActivationEndTime.GetTicks() > 0)
+			{
+				NodeRecord.DurationSec = (ActivationEndTime - ActivationStartTime).GetTotalSeconds();
+			}
+		}
+	}
+
+	for (int32 NodeIndex = 0; NodeIndex < StructNodes.Num(); ++NodeIndex)
+	{
+		if (StructNodeStates[NodeIndex] == EAutomationGraphNodeState::Uninitialized)
+		{
+			continue;
+		}
+
+		FAutomationGraphNodeRunRecord& NodeRecord = CurrentRunRecord.Nodes.AddDefaulted_GetRef();
+		NodeRecord.NodeName = FString::Printf(TEXT("StructNode_%d"), NodeIndex);
+		NodeRecord.Title = StructNodes[NodeIndex]->Title;
+		NodeRecord.State = StructNodeStates[NodeIndex];
+		if (TargetGraph.IsValid())
+		{
+			NodeRecord.NodeClass = TargetGraph->StructNodes[NodeIndex].GetScriptStruct()->GetName();
+		}
+		
+		if (StructNodeStartTimes[NodeIndex].GetTicks() > 0)
+		{
+			NodeRecord.StartOffsetSec = (StructNodeStartTimes[NodeIndex] - CurrentRunRecord.StartTime).GetTotalSeconds();
+			if (StructNodeEndTimes[NodeIndex].GetTicks() > 0)
+			{
+				NodeRecord.DurationSec = (StructNodeEndTimes[NodeIndex] - StructNodeStartTimes[NodeIndex]).GetTotalSeconds();
+			}
+		}
+	}
+
+	FAutomationGraphHistory::AppendRunRecord(CurrentRunRecord);
+}
+
+bool UAutomationGraphExecutor::ApplyDirtySubgraph(const TSet<UAutomationGraphNode*>& DirtyNodes)
+{
+	TSet<UAutomationGraphNode*> InitializedNodes;
+	InitializedNodes.Reserve(ExecutionNodes.Num());
+	for (TWeakObjectPtr<UAutomationGraphNode> WeakNode : ExecutionNodes)
+	{
+		InitializedNodes.Add(WeakNode.Get());
+	}
+
+	// Downstream closure of the dirty nodes. Dirty nodes that weren't initialized aren't reachable from this trigger.
+	TSet<UAutomationGraphNode*> DirtySubgraph;
+	TArray<UAutomationGraphNode*> NodeStack;
+	for (UAutomationGraphNode* DirtyNode : DirtyNodes)
+	{
+		if (InitializedNodes.Contains(DirtyNode))
+		{
+			NodeStack.Add(DirtyNode);
+			ForcedNodes.Add(DirtyNode);
+		}
+	}
+	
+	while (!NodeStack.IsEmpty())
+	{
+		UAutomationGraphNode* Node = NodeStack.Pop(EAllowShrinking::No);
+		bool bAlreadyInSet = false;
+		DirtySubgraph.Add(Node, &bAlreadyInSet);
+		if (!bAlreadyInSet)
+		{
+			NodeStack.Append(Node->ChildNodes);
+		}
+	}
+
+	if (DirtySubgraph.IsEmpty())
+	{
+		return false;
+	}
+
+	// Finish everything outside the subgraph with its previous result. Finished nodes that feed into the subgraph stay
+	// active for one tick so that the executor starts their children, the same as it would for a full run.
+	ActiveNodes.Empty();
+	for (UAutomationGraphNode* Node : InitializedNodes)
+	{
+		if (DirtySubgraph.Contains(Node))
+		{
+			ResultTable.RemoveOutputs(Node);
+			ArtifactStore.RemoveArtifacts(Node);
+			if (Node->ParentNodes.IsEmpty())
+			{
+				ActiveNodes.Add(Node);
+			}
+			continue;
+		}
+		
+		Node->FinishWithPreviousResult();
+		for (UAutomationGraphNode* ChildNode : Node->ChildNodes)
+		{
+			if (DirtySubgraph.Contains(ChildNode))
+			{
+				ActiveNodes.Add(Node);
+				break;
+			}
+		}
+	}
+
+	AG_LOG_OBJECT(this, LogAutoGraphRuntime, Log, TEXT("Running %d of %d nodes."), DirtySubgraph.Num(), InitializedNodes.Num());
+	return true;
+}
+
+bool UAutomationGraphExecutor::ValidateDataSlots()
+{
+	TArray<FAutomationGraphDataSlot> InputSlots;
+	TArray<FAutomationGraphDataSlot> OutputSlots;
+	TArray<UAutomationGraphNode*> NodeQueue;
+	TSet<UAutomationGraphNode*> Visited;
+	
+	for (TWeakObjectPtr<UAutomationGraphNode> WeakNode : ExecutionNodes)
+	{
+		UAutomationGraphNode* Node = WeakNode.Get();
+		if (!Node)
+		{
+			continue;
+		}
+
+		InputSlots.Reset();
+		Node->GetInputSlots(InputSlots);
+		
+		for (const FAutomationGraphDataSlot& InputSlot : InputSlots)
+		{
+			if (!InputSlot.bRequired)
+			{
+				continue;
+			}
+
+			// Same search order as UAutomationGraphNode::FindInput().
+			const FName SourceName = Node->GetInputSource(InputSlot.Name);
+			bool bFoundOutput = false;
+			NodeQueue.Reset();
+			NodeQueue.Append(Node->ParentNodes);
+			Visited.Reset();
+			Visited.Append(NodeQueue);
+			
+			for (int32 QueueIndex = 0; QueueIndex < NodeQueue.Num() && !bFoundOutput; ++QueueIndex)
+			{
+				UAutomationGraphNode* AncestorNode = NodeQueue[QueueIndex];
+				
+				OutputSlots.Reset();
+				AncestorNode->GetOutputSlots(OutputSlots);
+				const FAutomationGraphDataSlot* OutputSlot = OutputSlots.FindByPredicate([SourceName](const FAutomationGraphDataSlot& Slot)
+				{
+					return Slot.Name == SourceName;
+				});
+
+				if (OutputSlot)
+				{
+					// The nearest output is the one that will be read, so it has to have the right type.
+					if (!OutputSlot->Type || !OutputSlot->Type->IsChildOf(InputSlot.Type))
+					{
+						AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Failed to start graph execution: input %s of %s expects %s, but %s outputs %s."),
+							*InputSlot.Name.ToString(), *Node->GetName(), *GetNameSafe(InputSlot.Type), *AncestorNode->GetName(), *GetNameSafe(OutputSlot->Type));
+						return false;
+					}
+					bFoundOutput = true;
+					break;
+				}
+
+				for (UAutomationGraphNode* ParentNode : AncestorNode->ParentNodes)
+				{
+					bool bAlreadyInSet = false;
+					Visited.Add(ParentNode, &bAlreadyInSet);
+					if (!bAlreadyInSet)
+					{
+						NodeQueue.Add(ParentNode);
+					}
+				}
+			}
+
+			if (!bFoundOutput)
+			{
+				AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Failed to start graph execution: required input %s of %s is not connected to an upstream %s output."),
+					*InputSlot.Name.ToString(), *Node->GetName(), *SourceName.ToString());
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool UAutomationGraphExecutor::TryFinishFromCache(UAutomationGraphNode* Node)
+{
+	if (!bUseResultCache || NodeCacheKeys.Contains(Node))
+	{
+		return false;
+	}
+
+	// Dirty nodes always run, but still compute their key below so that their children see the new inputs.
+	const bool bCanUseCache = !ForcedNodes.Contains(Node) && !CVarIgnoreResultCache.GetValueOnGameThread();
+
+	// Nodes that aren't cacheable get an empty key, so that they are only checked once per run.
+	NodeCacheKeys.Add(Node, FString());
+	
+	TArray<FAutomationGraphDataSlot> OutputSlots;
+	Node->GetOutputSlots(OutputSlots);
+	if (!OutputSlots.IsEmpty())
+	{
+		return false;
+	}
+	
+	FAutomationGraphCacheInputs Inputs;
+	Inputs.AddString(Node->GetClass()->GetPathName());
+	if (!Node->GatherCacheInputs(Inputs))
+	{
+		return false;
+	}
+	if (!Inputs.IsValid())
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Log, TEXT("Not using the result cache for %s: %s"), *Node->GetName(), *Inputs.GetInvalidReason());
+		return false;
+	}
+
+	// Upstream results. Parents that aren't cacheable contribute a hash of what they produced this run, so a child of a
+	// node that re-ran with different outputs isn't finished from the cache.
+	for (UAutomationGraphNode* ParentNode : Node->ParentNodes)
+	{
+		const FString* ParentKey = NodeCacheKeys.Find(ParentNode);
+		if (!ParentKey || ParentKey->IsEmpty())
+		{
+			ParentKey = NodeResultKeys.Find(ParentNode);
+		}
+		if (!ParentKey)
+		{
+			AG_LOG_OBJECT(this, LogAutoGraphRuntime, Log, TEXT("Not using the result cache for %s: the result of %s is unknown."), *Node->GetName(), *ParentNode->GetName());
+			return false;
+		}
+		Inputs.AddString(*ParentKey);
+	}
+
+	FString CacheKey = Inputs.Finalize();
+	if (bCanUseCache && ResultCache.Contains(Node->GetName(), CacheKey))
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Log, TEXT("%s is unchanged since its last run. Using the cached result."), *Node->GetName());
+		Node->FinishFromCache();
+	}
+	
+	NodeCacheKeys.Add(Node, MoveTemp(CacheKey));
+	return Node->IsFinishedFromCache();
+}
+
+void UAutomationGraphExecutor::UpdateResultCache(UAutomationGraphNode* Node)
+{
+	if (!bUseResultCache)
+	{
+		return;
+	}
+
+	FString* CacheKey = NodeCacheKeys.Find(Node);
+	bool bCacheable = CacheKey && !CacheKey->IsEmpty();
+
+	// Nodes finished from the cache or with their previous result didn't run, so their cache entries are left alone.
+	const bool bDidRun = !Node->IsFinishedFromCache() && !Node->IsReusingPreviousResult();
+	
+	// Artifacts are deleted at the start of every full run, so a producer finished from the cache would leave its
+	// consumers with nothing to map. Nodes that publish artifacts are treated as not cacheable.
+	TArray<FName> ArtifactNames;
+	ArtifactStore.GetArtifacts(Node, ArtifactNames);
+	if (bCacheable && !ArtifactNames.IsEmpty() && bDidRun)
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Log, TEXT("Not caching the result of %s, since it published artifacts."), *Node->GetName());
+		ResultCache.Remove(Node->GetName());
+		CacheKey->Empty();
+		bCacheable = false;
+	}
+	
+	if (!bCacheable && Node->GetState() == EAutomationGraphNodeState::Finished)
+	{
+		NodeResultKeys.Add(Node, MakeResultKey(Node));
+	}
+	
+	if (!bCacheable || !bDidRun)
+	{
+		return;
+	}
+
+	if (Node->GetState() == EAutomationGraphNodeState::Finished)
+	{
+		ResultCache.Store(Node->GetName(), *CacheKey);
+	}
+	else
+	{
+		ResultCache.Remove(Node->GetName());
+	}
+}
+
+FString UAutomationGraphExecutor::MakeResultKey(UAutomationGraphNode* Node) const
+{
+	FAutomationGraphCacheInputs Inputs;
+	Inputs.AddString(Node->GetPathName());
+
+	for (UAutomationGraphNode* ParentNode : Node->ParentNodes)
+	{
+		const FString* ParentKey = NodeCacheKeys.Find(ParentNode);
+		if (!ParentKey || ParentKey->IsEmpty())
+		{
+			ParentKey = NodeResultKeys.Find(ParentNode);
+		}
+		Inputs.AddString(ParentKey ? *ParentKey : FString(TEXT("unknown")));
+	}
+
+	TArray<FAutomationGraphDataSlot> OutputSlots;
+	Node->GetOutputSlots(OutputSlots);
+	for (const FAutomationGraphDataSlot& OutputSlot : OutputSlots)
+	{
+		Inputs.AddString(OutputSlot.Name.ToString());
+		if (const FInstancedStruct* Value = ResultTable.FindOutput(Node, OutputSlot.Name))
+		{
+			Inputs.AddStruct(*Value);
+		}
+		else
+		{
+			Inputs.AddString(TEXT("missing"));
+		}
+	}
+
+	TArray<FName> ArtifactNames;
+	ArtifactStore.GetArtifacts(Node, ArtifactNames);
+	ArtifactNames.Sort(FNameLexicalLess());
+	for (FName ArtifactName : ArtifactNames)
+	{
+		Inputs.AddString(ArtifactName.ToString());
+		Inputs.AddFile(ArtifactStore.GetArtifactFilePath(ArtifactName));
+	}
+	
+	return Inputs.Finalize();
+}
+
+EAutomationGraphNodeState UAutomationGraphExecutor::GetStructNodeState(int32 NodeIndex) const
+{
+	return StructNodeStates.IsValidIndex(NodeIndex) ? StructNodeStates[NodeIndex] : EAutomationGraphNodeState::Uninitialized;
+}
+
+bool UAutomationGraphExecutor::StartStructExecution(const FGraphExecutionTask& ExecutionTask)
+{
+	UAutomationGraph* Graph = TargetGraph.Get();
+	if (!Graph || Graph->StructNodes.IsEmpty())
+	{
+		return true;
+	}
+
+	const int32 NodeCount = Graph->StructNodes.Num();
+	
+	FString Error;
+	if (!StructAdjacency.Build(NodeCount, Graph->StructEdges, Error))
+	{
+		AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Failed to start graph execution: %s"), *Error);
+		return false;
+	}
+
+	StructNodes.SetNumUninitialized(NodeCount);
+	for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
+	{
+		StructNodes[NodeIndex] = Graph->StructNodes[NodeIndex].GetMutablePtr<FAutomationGraphStructNode>();
+		if (!StructNodes[NodeIndex])
+		{
+			AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("Failed to start graph execution: struct node %d is invalid."), NodeIndex);
+			return false;
+		}
+	}
+
+	StructNodeStates.Init(EAutomationGraphNodeState::Uninitialized, NodeCount);
+	StructNodeElapsedSec.Init(0.0f, NodeCount);
+	StructNodeRemainingParents = StructAdjacency.ParentCounts;
+	StructNodeStartTimes.Init(FDateTime(), NodeCount);
+	StructNodeEndTimes.Init(FDateTime(), NodeCount);
+
+	// Initialize every node reachable from a triggered root. Nodes that are not reachable stay uninitialized.
+	TArray<int32> NodeStack;
+	for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
+	{
+		if (StructAdjacency.ParentCounts[NodeIndex] != 0)
+		{
+			continue;
+		}
+
+		bool bTriggered = StructNodes[NodeIndex]->HasTrigger(ExecutionTask.Trigger);
+		for (EAutomationGraphNodeTrigger MergedTrigger : ExecutionTask.MergedTriggers)
+		{
+			bTriggered = bTriggered || StructNodes[NodeIndex]->HasTrigger(MergedTrigger);
+		}
+		
+		if (bTriggered)
+		{
+			NodeStack.Add(NodeIndex);
+			ActiveStructNodes.Add(NodeIndex);
+		}
+	}
+
+	UWorld* World = ExecutionTask.TargetWorld.Get();
+	while (!NodeStack.IsEmpty())
+	{
+		int32 NodeIndex = NodeStack.Pop(EAllowShrinking::No);
+		if (StructNodeStates[NodeIndex] != EAutomationGraphNodeState::Uninitialized)
+		{
+			continue;
+		}
+
+		bool bInitialized = StructNodes[NodeIndex]->Initialize(World);
+		SetStructNodeState(NodeIndex, bInitialized ? EAutomationGraphNodeState::Standby : EAutomationGraphNodeState::Error);
+		TConstArrayView<int32> Children = StructAdjacency.GetChildren(NodeIndex);
+		NodeStack.Append(Children.GetData(), Children.Num());
+	}
+
+	return true;
+}
+
+void UAutomationGraphExecutor::ExecuteStructNodes(float DeltaSeconds)
+{
+	TArray<int32> ReadyNodes;
+	
+	for (int32 ActiveIndex = 0; ActiveIndex < ActiveStructNodes.Num();)
+	{
+		const int32 NodeIndex = ActiveStructNodes[ActiveIndex];
+		FAutomationGraphStructNode* StructNode = StructNodes[NodeIndex];
+		EAutomationGraphNodeState NodeState = StructNodeStates[NodeIndex];
+
+		if (NodeState == EAutomationGraphNodeState::Standby)
+		{
+			SetStructNodeState(NodeIndex, EAutomationGraphNodeState::Active);
+			NodeState = EAutomationGraphNodeState::Active;
+		}
+		else if (NodeState == EAutomationGraphNodeState::Active)
+		{
+			StructNodeElapsedSec[NodeIndex] += DeltaSeconds;
+		}
+
+		if (NodeState == EAutomationGraphNodeState::Active)
+		{
+			if (StructNodeElapsedSec[NodeIndex] >= StructNode->NodeTimeoutSec)
+			{
+				NodeState = EAutomationGraphNodeState::Expired;
+			}
+			else
+			{
+				NodeState = StructNode->Activate(DeltaSeconds, StructNodeElapsedSec[NodeIndex]);
+			}
+			
+			if (NodeState < EAutomationGraphNodeState::Active)
+			{
+				AG_LOG_OBJECT(this, LogAutoGraphRuntime, Error, TEXT("unexpected build state for struct node %d: %s."), NodeIndex, *UEnum::GetValueAsString(NodeState));
+				NodeState = EAutomationGraphNodeState::Error;
+			}
+			SetStructNodeState(NodeIndex, NodeState);
+		}
+
+		if (NodeState == EAutomationGraphNodeState::Active)
+		{
+			++ActiveIndex;
+			continue;
+		}
+
+		StructNode->Cleanup();
+		
+		if (NodeState == EAutomationGraphNodeState::Finished)
+		{
+			for (int32 ChildIndex : StructAdjacency.GetChildren(NodeIndex))
+			{
+				if (--StructNodeRemainingParents[ChildIndex] == 0 && StructNodeStates[ChildIndex] == EAutomationGraphNodeState::Standby)
+				{
+					ReadyNodes.Add(ChildIndex);
+				}
+			}
+		}
+		
+		ActiveStructNodes.RemoveAtSwap(ActiveIndex, 1, EAllowShrinking::No);
+	}
+
+	ActiveStructNodes.Append(ReadyNodes);
+}
+
+void UAutomationGraphExecutor::CancelStructNodes()
+{
+	for (int32 NodeIndex = 0; NodeIndex < StructNodes.Num(); ++NodeIndex)
+	{
+		EAutomationGraphNodeState NodeState = StructNodeStates[NodeIndex];
+		if (NodeState == EAutomationGraphNodeState::Standby || NodeState == EAutomationGraphNodeState::Active)
+		{
+			StructNodes[NodeIndex]->Cancel();
+			SetStructNodeState(NodeIndex, EAutomationGraphNodeState::Cancelled);
+			StructNodes[NodeIndex]->Cleanup();
+		}
+	}
+	
+	ActiveStructNodes.Empty();
+}
+
+void UAutomationGraphExecutor::SetStructNodeState(int32 NodeIndex, EAutomationGraphNodeState NewState)
+{
+	EAutomationGraphNodeState PreviousState = StructNodeStates[NodeIndex];
+	StructNodeStates[NodeIndex] = NewState;
+
+	if (NewState == EAutomationGraphNodeState::Active && PreviousState != EAutomationGraphNodeState::Active)
+	{
+		StructNodeElapsedSec[NodeIndex] = 0.0f;
+		StructNodeStartTimes[NodeIndex] = FDateTime::UtcNow();
+	}
+	else if (NewState >= EAutomationGraphNodeState::Finished && PreviousState < EAutomationGraphNodeState::Finished)
+	{
+		StructNodeEndTimes[NodeIndex] = FDateTime::UtcNow();
+	}
+}
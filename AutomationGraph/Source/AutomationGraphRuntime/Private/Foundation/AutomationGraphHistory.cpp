@@ -0,0 +1,255 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Foundation/AutomationGraphHistory.h"
+
+#include "AutomationGraphRuntimeLoggingDefs.h"
+#include "JsonObjectConverter.h"
+#include "Foundation/AutomationGraph.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Macros/AutomationGraphLoggingMacros.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+namespace AutomationGraphHistory
+{
+	static FAutoConsoleCommand ExportTraceCommand(
+		TEXT("AutomationGraph.ExportTrace"),
+		TEXT("Exports the execution history of a graph as a Chrome trace. Usage: AutomationGraph.ExportTrace <GraphPath> [OutputFile] [MaxRuns]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.IsEmpty())
+			{
+				AG_LOG(LogAutoGraphRuntime, Error, TEXT("AutomationGraph.ExportTrace: expected a graph path."));
+				return;
+			}
+
+			const FString& GraphPath = Args[0];
+			FString OutputFilePath = Args.IsValidIndex(1) ? Args[1] : FPaths::ChangeExtension(FAutomationGraphHistory::GetHistoryFilePath(GraphPath), TEXT("trace.json"));
+			int32 MaxRuns = Args.IsValidIndex(2) ? FCString::Atoi(*Args[2]) : 0;
+
+			TArray<FAutomationGraphRunRecord> Records;
+			if (!FAutomationGraphHistory::LoadRunRecords(GraphPath, Records, MaxRuns))
+			{
+				return;
+			}
+			if (FAutomationGraphHistory::ExportChromeTrace(Records, OutputFilePath))
+			{
+				AG_LOG(LogAutoGraphRuntime, Log, TEXT("Exported %d runs to %s"), Records.Num(), *OutputFilePath);
+			}
+		})
+	);
+}
+
+FString FAutomationGraphHistory::GetHistoryFilePath(const FString& GraphPath)
+{
+	// Strip the object name if this is a full object path ("/Game/Foo/Bar.Bar" -> "/Game/Foo/Bar").
+	FString PackageName = GraphPath;
+	int32 DotIndex = INDEX_NONE;
+	if (PackageName.FindChar(TEXT('.'), DotIndex))
+	{
+		PackageName.LeftInline(DotIndex);
+	}
+	
+	PackageName.RemoveFromStart(TEXT("/"));
+	PackageName.ReplaceCharInline(TEXT('/'), TEXT('.'));
+	
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AutomationGraph"), TEXT("History"), FPaths::MakeValidFileName(PackageName) + TEXT(".jsonl"));
+}
+
+FString FAutomationGraphHistory::GetHistoryFilePath(UAutomationGraph* Graph)
+{
+	if (!Graph)
+	{
+		return FString();
+	}
+	
+	return GetHistoryFilePath(Graph->GetPathName());
+}
+
+bool FAutomationGraphHistory::AppendRunRecord(const FAutomationGraphRunRecord& Record)
+{
+	FString RecordLine;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(Record, RecordLine, 0, 0, 0, nullptr, false))
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Failed to serialize run record for %s"), *Record.GraphPath);
+		return false;
+	}
+	RecordLine += LINE_TERMINATOR;
+
+	FString FilePath = GetHistoryFilePath(Record.GraphPath);
+	bool bSaved = FFileHelper::SaveStringToFile(
+		RecordLine,
+		*FilePath,
+		FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+		&IFileManager::Get(),
+		FILEWRITE_Append
+	);
+
+	if (!bSaved)
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Failed to write run record to %s"), *FilePath);
+	}
+
+	return bSaved;
+}
+
+bool FAutomationGraphHistory::LoadRunRecords(const FString& GraphPath, TArray<FAutomationGraphRunRecord>& OutRecords, int32 MaxRuns)
+{
+	OutRecords.Empty();
+	
+	FString FilePath = GetHistoryFilePath(GraphPath);
+	TArray<FString> RecordLines;
+	if (!FFileHelper::LoadFileToStringArray(RecordLines, *FilePath))
+	{
+		AG_LOG(LogAutoGraphRuntime, Warning, TEXT("No execution history found at %s"), *FilePath);
+		return false;
+	}
+
+	int32 FirstLine = MaxRuns > 0 ? FMath::Max(0, RecordLines.Num() - MaxRuns) : 0;
+	OutRecords.Reserve(RecordLines.Num() - FirstLine);
+	
+	for (int32 LineIndex = FirstLine; LineIndex < RecordLines.Num(); ++LineIndex)
+	{
+		if (RecordLines[LineIndex].IsEmpty())
+		{
+			continue;
+		}
+		
+		FAutomationGraphRunRecord Record;
+		if (!FJsonObjectConverter::JsonObjectStringToUStruct(RecordLines[LineIndex], &Record))
+		{
+			AG_LOG(LogAutoGraphRuntime, Warning, TEXT("Skipping malformed run record on line %d of %s"), LineIndex + 1, *FilePath);
+			continue;
+		}
+		OutRecords.Add(MoveTemp(Record));
+	}
+
+	return true;
+}
+
+void FAutomationGraphHistory::GetAverageNodeDurations(const TArray<FAutomationGraphRunRecord>& Records, TMap<FString, float>& OutDurations)
+{
+	OutDurations.Empty();
+	TMap<FString, int32> SampleCounts;
+
+	for (const FAutomationGraphRunRecord& Record : Records)
+	{
+		for (const FAutomationGraphNodeRunRecord& NodeRecord : Record.Nodes)
+		{
+			if (NodeRecord.State != EAutomationGraphNodeState::Finished || NodeRecord.bCached || NodeRecord.bReused)
+			{
+				continue;
+			}
+			
+			OutDurations.FindOrAdd(NodeRecord.NodeName) += NodeRecord.DurationSec;
+			SampleCounts.FindOrAdd(NodeRecord.NodeName)++;
+		}
+	}
+
+	for (TPair<FString, float>& Duration : OutDurations)
+	{
+		Duration.Value /= SampleCounts[Duration.Key];
+	}
+}
+
+bool FAutomationGraphHistory::ExportChromeTrace(const TArray<FAutomationGraphRunRecord>& Records, const FString& OutputFilePath)
+{
+	if (Records.IsEmpty())
+	{
+		AG_LOG(LogAutoGraphRuntime, Warning, TEXT("No run records to export."));
+		return false;
+	}
+
+	// Timestamps are in microseconds, relative to the start of the first run.
+	const FDateTime TraceStartTime = Records[0].StartTime;
+	
+	FString TraceString;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&TraceString);
+
+	Writer->WriteObjectStart();
+	Writer->WriteArrayStart(TEXT("traceEvents"));
+
+	// Each run is displayed as its own process, and each node in that run gets its own thread so that nodes running
+	// concurrently don't overlap.
+	for (int32 RunIndex = 0; RunIndex < Records.Num(); ++RunIndex)
+	{
+		const FAutomationGraphRunRecord& Record = Records[RunIndex];
+		const double RunStartUs = (Record.StartTime - TraceStartTime).GetTotalMicroseconds();
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), TEXT("process_name"));
+		Writer->WriteValue(TEXT("ph"), TEXT("M"));
+		Writer->WriteValue(TEXT("pid"), RunIndex);
+		Writer->WriteObjectStart(TEXT("args"));
+		Writer->WriteValue(TEXT("name"), FString::Printf(TEXT("%s (%s)"), *Record.StartTime.ToString(), *UEnum::GetDisplayValueAsText(Record.Trigger).ToString()));
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectEnd();
+
+		for (int32 NodeIndex = 0; NodeIndex < Record.Nodes.Num(); ++NodeIndex)
+		{
+			const FAutomationGraphNodeRunRecord& NodeRecord = Record.Nodes[NodeIndex];
+			if (NodeRecord.StartOffsetSec < 0.0f)
+			{
+				continue;
+			}
+
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("name"), NodeRecord.Title.IsEmpty() ? NodeRecord.NodeName : NodeRecord.Title);
+			Writer->WriteValue(TEXT("cat"), NodeRecord.NodeClass);
+			Writer->WriteValue(TEXT("ph"), TEXT("X"));
+			Writer->WriteValue(TEXT("pid"), RunIndex);
+			Writer->WriteValue(TEXT("tid"), NodeIndex);
+			Writer->WriteValue(TEXT("ts"), RunStartUs + NodeRecord.StartOffsetSec * 1000000.0);
+			Writer->WriteValue(TEXT("dur"), NodeRecord.DurationSec * 1000000.0);
+			Writer->WriteObjectStart(TEXT("args"));
+			Writer->WriteValue(TEXT("state"), UEnum::GetDisplayValueAsText(NodeRecord.State).ToString());
+			Writer->WriteValue(TEXT("node"), NodeRecord.NodeName);
+			Writer->WriteObjectEnd();
+			Writer->WriteObjectEnd();
+		}
+	}
+
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	if (!FFileHelper::SaveStringToFile(TraceString, *OutputFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Failed to write trace to %s"), *OutputFilePath);
+		return false;
+	}
+
+	return true;
+}
@@ -47,6 +47,8 @@ void UAutomationGraphNode::Uninitialize()
 {
 	Cleanup();
 	SetState(EAutomationGraphNodeState::Uninitialized);
+	ResultTable = nullptr;
+	ArtifactStore = nullptr;
 }
 
 bool UAutomationGraphNode::CanStartActivation()
@@ -81,7 +83,7 @@ bool UAutomationGraphNode::CanActivate()
 
 EAutomationGraphNodeState UAutomationGraphNode::Activate(float DeltaSeconds)
 {
-	if (NodeState == EAutomationGraphNodeState::Active)
+	if (NodeState == EAutomationGraphNodeState::Active && IsTimeoutRunning())
 	{
 		TimeElapsedSec += DeltaSeconds;
 	}
@@ -94,6 +96,24 @@ EAutomationGraphNodeState UAutomationGraphNode::Activate(float DeltaSeconds)
 	return ActivateInternal(DeltaSeconds);
 }
 
+void UAutomationGraphNode::FinishFromCache()
+{
+	if (NodeState == EAutomationGraphNodeState::Standby)
+	{
+		SetState(EAutomationGraphNodeState::Finished);
+		bFinishedFromCache = true;
+	}
+}
+
+void UAutomationGraphNode::FinishWithPreviousResult()
+{
+	if (NodeState == EAutomationGraphNodeState::Standby)
+	{
+		SetState(EAutomationGraphNodeState::Finished);
+		bReusingPreviousResult = true;
+	}
+}
+
 void UAutomationGraphNode::Cancel()
 {
 	if(NodeState < EAutomationGraphNodeState::Finished)
@@ -121,6 +141,7 @@ EAutomationGraphNodeState UAutomationGraphNode::ActivateInternal(float DeltaSeco
 
 EAutomationGraphNodeState UAutomationGraphNode::SetState(EAutomationGraphNodeState NewState)
 {
+	EAutomationGraphNodeState PreviousState = NodeState;
 	NodeState = NewState;
 
 	switch (NodeState)
@@ -128,6 +149,25 @@ EAutomationGraphNodeState UAutomationGraphNode::SetState(EAutomationGraphNodeSta
 	case EAutomationGraphNodeState::Uninitialized:
 	case EAutomationGraphNodeState::Standby:
 		TimeElapsedSec = 0.0f;
+		ActivationStartTime = FDateTime();
+		ActivationEndTime = FDateTime();
+		bFinishedFromCache = false;
+		bReusingPreviousResult = false;
+		break;
+	case EAutomationGraphNodeState::Active:
+		if (PreviousState != EAutomationGraphNodeState::Active)
+		{
+			ActivationStartTime = FDateTime::UtcNow();
+		}
+		break;
+	case EAutomationGraphNodeState::Finished:
+	case EAutomationGraphNodeState::Expired:
+	case EAutomationGraphNodeState::Cancelled:
+	case EAutomationGraphNodeState::Error:
+		if (PreviousState < EAutomationGraphNodeState::Finished)
+		{
+			ActivationEndTime = FDateTime::UtcNow();
+		}
 		break;
 	default:
 		break;
@@ -136,6 +176,63 @@ EAutomationGraphNodeState UAutomationGraphNode::SetState(EAutomationGraphNodeSta
 	return NodeState;
 }
 
+FName UAutomationGraphNode::GetInputSource(FName InputName) const
+{
+	const FName* SourceName = InputSources.Find(InputName);
+	return SourceName && !SourceName->IsNone() ? *SourceName : InputName;
+}
+
+const FInstancedStruct* UAutomationGraphNode::FindInput(FName SlotName)
+{
+	if (!ResultTable)
+	{
+		return nullptr;
+	}
+
+	const FName SourceName = GetInputSource(SlotName);
+
+	// Breadth first, so that the closest producer wins.
+	TArray<UAutomationGraphNode*> NodeQueue(ParentNodes);
+	TSet<UAutomationGraphNode*> Visited;
+	Visited.Append(NodeQueue);
+	
+	for (int32 QueueIndex = 0; QueueIndex < NodeQueue.Num(); ++QueueIndex)
+	{
+		UAutomationGraphNode* AncestorNode = NodeQueue[QueueIndex];
+		if (const FInstancedStruct* Value = ResultTable->FindOutput(AncestorNode, SourceName))
+		{
+			return Value;
+		}
+
+		for (UAutomationGraphNode* ParentNode : AncestorNode->ParentNodes)
+		{
+			bool bAlreadyInSet = false;
+			Visited.Add(ParentNode, &bAlreadyInSet);
+			if (!bAlreadyInSet)
+			{
+				NodeQueue.Add(ParentNode);
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+bool UAutomationGraphNode::PublishArtifact(FName Name, TConstArrayView64<uint8> Data)
+{
+	return ArtifactStore && ArtifactStore->PublishArtifact(this, Name, Data);
+}
+
+bool UAutomationGraphNode::PublishArtifactFile(FName Name, const FString& SourceFilePath)
+{
+	return ArtifactStore && ArtifactStore->PublishArtifactFile(this, Name, SourceFilePath);
+}
+
+TSharedPtr<FAutomationGraphArtifactView> UAutomationGraphNode::MapArtifact(FName Name) const
+{
+	return ArtifactStore ? ArtifactStore->MapArtifact(Name) : nullptr;
+}
+
 FLinearColor UAutomationGraphNode::GetStateColor()
 {
 	switch(NodeState)
@@ -174,6 +271,14 @@ FString UAutomationGraphNode::GetMessageText()
 	case EAutomationGraphNodeState::Active:
 		return FString::Printf(TEXT("Active for %.2f Seconds"), TimeElapsedSec); 
 	case EAutomationGraphNodeState::Finished:
+		if (bFinishedFromCache)
+		{
+			return FString("Finished (cached)");
+		}
+		if (bReusingPreviousResult)
+		{
+			return FString("Finished (previous run)");
+		}
 		return FString::Printf(TEXT("Finished in %.2f Seconds"), TimeElapsedSec); 
 	case EAutomationGraphNodeState::Expired:
 		return FString("Expired.");
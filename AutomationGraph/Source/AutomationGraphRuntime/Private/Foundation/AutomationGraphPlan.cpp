@@ -0,0 +1,189 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Foundation/AutomationGraphPlan.h"
+
+#include "Foundation/AutomationGraph.h"
+#include "Foundation/AutomationGraphNode.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace AutomationGraphPlan
+{
+	static TMap<TObjectKey<UAutomationGraph>, TSharedPtr<const FAutomationGraphPlan>> PlanCache;
+
+#if WITH_EDITOR
+	static void OnObjectModified(UObject* Object)
+	{
+		if (PlanCache.IsEmpty() || !Object)
+		{
+			return;
+		}
+
+		const UAutomationGraph* Graph = Cast<UAutomationGraph>(Object);
+		if (!Graph)
+		{
+			Graph = Object->GetTypedOuter<UAutomationGraph>();
+		}
+		if (Graph)
+		{
+			FAutomationGraphPlan::Invalidate(Graph);
+		}
+	}
+#endif
+}
+
+TSharedPtr<const FAutomationGraphPlan> FAutomationGraphPlan::Get(UAutomationGraph* Graph, FString& OutError)
+{
+	if (!Graph)
+	{
+		OutError = TEXT("Graph is invalid.");
+		return nullptr;
+	}
+
+#if WITH_EDITOR
+	static FDelegateHandle ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddStatic(&AutomationGraphPlan::OnObjectModified);
+#endif
+	
+	if (const TSharedPtr<const FAutomationGraphPlan>* CachedPlan = AutomationGraphPlan::PlanCache.Find(Graph))
+	{
+		return *CachedPlan;
+	}
+
+	TSharedPtr<FAutomationGraphPlan> NewPlan = MakeShared<FAutomationGraphPlan>();
+	if (!NewPlan->Compile(Graph, OutError))
+	{
+		return nullptr;
+	}
+
+	AutomationGraphPlan::PlanCache.Add(Graph, NewPlan);
+	return NewPlan;
+}
+
+void FAutomationGraphPlan::Invalidate(const UAutomationGraph* Graph)
+{
+	AutomationGraphPlan::PlanCache.Remove(Graph);
+}
+
+bool FAutomationGraphPlan::Compile(UAutomationGraph* InGraph, FString& OutError)
+{
+	Graph = InGraph;
+	
+	TMap<UAutomationGraphNode*, int32> NodeIndices;
+	TArray<UAutomationGraphNode*> NodeStack;
+	for (UAutomationGraphNode* RootNode : InGraph->RootNodes)
+	{
+		NodeStack.Add(RootNode);
+	}
+
+	TArray<FAutomationGraphEdge> Edges;
+	while (!NodeStack.IsEmpty())
+	{
+		UAutomationGraphNode* Node = NodeStack.Pop(EAllowShrinking::No);
+		if (!Node)
+		{
+			OutError = FString::Printf(TEXT("%s contains an invalid node."), *InGraph->GetName());
+			return false;
+		}
+		if (NodeIndices.Contains(Node))
+		{
+			continue;
+		}
+
+		NodeIndices.Add(Node, Nodes.Add(Node));
+		NodeStack.Append(Node->ChildNodes);
+	}
+
+	for (const TPair<UAutomationGraphNode*, int32>& NodeIndex : NodeIndices)
+	{
+		for (UAutomationGraphNode* ChildNode : NodeIndex.Key->ChildNodes)
+		{
+			Edges.Emplace(NodeIndex.Value, NodeIndices[ChildNode]);
+		}
+	}
+
+	if (!Adjacency.Build(Nodes.Num(), Edges, OutError))
+	{
+		OutError = FString::Printf(TEXT("%s: %s"), *InGraph->GetName(), *OutError);
+		return false;
+	}
+
+	return true;
+}
+
+UAutomationGraph* FAutomationGraphPlan::Instantiate(UObject* Outer) const
+{
+	UAutomationGraph* SourceGraph = Graph.Get();
+	if (!SourceGraph)
+	{
+		return nullptr;
+	}
+
+	auto* Instance = NewObject<UAutomationGraph>(Outer, SourceGraph->GetClass(), NAME_None, RF_Transient);
+	Instance->SourceGraph = SourceGraph->GetSourceGraph();
+	Instance->StructNodes = SourceGraph->StructNodes;
+	Instance->StructEdges = SourceGraph->StructEdges;
+
+	// Instances are part of their parent's run, which already records history and owns the cache and artifacts.
+	Instance->bRecordExecutionHistory = false;
+	Instance->bUseResultCache = false;
+	Instance->ArtifactRetention = EAutomationGraphArtifactRetention::DeleteWhenRunEnds;
+
+	TArray<UAutomationGraphNode*> InstanceNodes;
+	InstanceNodes.Reserve(Nodes.Num());
+	for (TWeakObjectPtr<UAutomationGraphNode> TemplateNode : Nodes)
+	{
+		if (!TemplateNode.IsValid())
+		{
+			return nullptr;
+		}
+
+		UAutomationGraphNode* InstanceNode = DuplicateObject<UAutomationGraphNode>(TemplateNode.Get(), Instance);
+		InstanceNode->ParentNodes.Reset();
+		InstanceNode->ChildNodes.Reset();
+		InstanceNodes.Add(InstanceNode);
+	}
+
+	for (int32 NodeIndex = 0; NodeIndex < InstanceNodes.Num(); ++NodeIndex)
+	{
+		for (int32 ChildIndex : Adjacency.GetChildren(NodeIndex))
+		{
+			InstanceNodes[NodeIndex]->ChildNodes.Add(InstanceNodes[ChildIndex]);
+			InstanceNodes[ChildIndex]->ParentNodes.Add(InstanceNodes[NodeIndex]);
+		}
+		
+		if (Adjacency.ParentCounts[NodeIndex] == 0)
+		{
+			Instance->RootNodes.Add(InstanceNodes[NodeIndex]);
+		}
+	}
+
+	return Instance;
+}
@@ -0,0 +1,225 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Foundation/AutomationGraphResultCache.h"
+
+#include "AutomationGraphRuntimeLoggingDefs.h"
+#include "JsonObjectConverter.h"
+#include "Foundation/AutomationGraphHistory.h"
+#include "Foundation/AutomationGraphNode.h"
+#include "InstancedStruct.h"
+#include "Macros/AutomationGraphLoggingMacros.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+void FAutomationGraphCacheInputs::AddString(FStringView Value)
+{
+	// Include the length so that ("ab", "c") and ("a", "bc") hash differently.
+	const int32 Length = Value.Len();
+	Hasher.Update(reinterpret_cast<const uint8*>(&Length), sizeof(Length));
+	Hasher.Update(reinterpret_cast<const uint8*>(Value.GetData()), Length * sizeof(TCHAR));
+}
+
+void FAutomationGraphCacheInputs::AddProperties(const UObject* Object, const UClass* StopAtClass)
+{
+	if (!Object)
+	{
+		Invalidate(TEXT("null object"));
+		return;
+	}
+	if (!StopAtClass)
+	{
+		StopAtClass = UAutomationGraphNode::StaticClass();
+	}
+
+	for (TFieldIterator<FProperty> PropertyIt(Object->GetClass()); PropertyIt; ++PropertyIt)
+	{
+		const FProperty* Property = *PropertyIt;
+		const UClass* OwnerClass = Property->GetOwnerClass();
+		if (!OwnerClass || StopAtClass->IsChildOf(OwnerClass) || Property->HasAnyPropertyFlags(CPF_Transient))
+		{
+			continue;
+		}
+
+		FString ValueText;
+		Property->ExportTextItem_InContainer(ValueText, Object, nullptr, nullptr, PPF_None);
+		AddString(Property->GetName());
+		AddString(ValueText);
+	}
+}
+
+void FAutomationGraphCacheInputs::AddStruct(const FInstancedStruct& Value)
+{
+	const UScriptStruct* ScriptStruct = Value.GetScriptStruct();
+	if (!ScriptStruct)
+	{
+		AddString(TEXT("empty"));
+		return;
+	}
+
+	FString ValueText;
+	ScriptStruct->ExportText(ValueText, Value.GetMemory(), nullptr, nullptr, PPF_None, nullptr);
+	AddString(ScriptStruct->GetPathName());
+	AddString(ValueText);
+}
+
+void FAutomationGraphCacheInputs::AddFile(const FString& FilePath)
+{
+	AddString(FilePath);
+	
+	FMD5Hash FileHash = FMD5Hash::HashFile(*FilePath);
+	AddString(FileHash.IsValid() ? LexToString(FileHash) : FString(TEXT("missing")));
+}
+
+void FAutomationGraphCacheInputs::AddAsset(const FSoftObjectPath& AssetPath)
+{
+	const FString PackageName = AssetPath.GetLongPackageName();
+	AddString(PackageName);
+
+	if (UPackage* LoadedPackage = FindPackage(nullptr, *PackageName))
+	{
+		if (LoadedPackage->IsDirty())
+		{
+			Invalidate(FString::Printf(TEXT("%s has unsaved changes"), *PackageName));
+			return;
+		}
+	}
+
+	FString PackageFilePath;
+	if (!FPackageName::DoesPackageExist(PackageName, &PackageFilePath))
+	{
+		AddString(TEXT("missing"));
+		return;
+	}
+	
+	AddFile(PackageFilePath);
+}
+
+void FAutomationGraphCacheInputs::Invalidate(const FString& Reason)
+{
+	if (bValid)
+	{
+		bValid = false;
+		InvalidReason = Reason;
+	}
+}
+
+FString FAutomationGraphCacheInputs::Finalize()
+{
+	Hasher.Final();
+	
+	FSHAHash Hash;
+	Hasher.GetHash(Hash.Hash);
+	return Hash.ToString();
+}
+
+FString FAutomationGraphResultCache::GetCacheFilePath(const FString& GraphPath)
+{
+	// Use the same file naming as the history store so the two are easy to match up.
+	FString HistoryFileName = FPaths::GetBaseFilename(FAutomationGraphHistory::GetHistoryFilePath(GraphPath));
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AutomationGraph"), TEXT("Cache"), HistoryFileName + TEXT(".json"));
+}
+
+void FAutomationGraphResultCache::Load(const FString& InGraphPath)
+{
+	Reset();
+	GraphPath = InGraphPath;
+
+	FString FilePath = GetCacheFilePath(GraphPath);
+	FString CacheString;
+	if (!FFileHelper::LoadFileToString(CacheString, *FilePath))
+	{
+		return;
+	}
+	
+	if (!FJsonObjectConverter::JsonObjectStringToUStruct(CacheString, &Data))
+	{
+		AG_LOG(LogAutoGraphRuntime, Warning, TEXT("Ignoring malformed result cache at %s"), *FilePath);
+		Data = FAutomationGraphResultCacheData();
+	}
+}
+
+bool FAutomationGraphResultCache::Save()
+{
+	if (!bDirty || GraphPath.IsEmpty())
+	{
+		return true;
+	}
+
+	FString CacheString;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(Data, CacheString))
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Failed to serialize result cache for %s"), *GraphPath);
+		return false;
+	}
+
+	FString FilePath = GetCacheFilePath(GraphPath);
+	if (!FFileHelper::SaveStringToFile(CacheString, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		AG_LOG(LogAutoGraphRuntime, Error, TEXT("Failed to write result cache to %s"), *FilePath);
+		return false;
+	}
+
+	bDirty = false;
+	return true;
+}
+
+void FAutomationGraphResultCache::Reset()
+{
+	GraphPath.Empty();
+	Data = FAutomationGraphResultCacheData();
+	bDirty = false;
+}
+
+bool FAutomationGraphResultCache::Contains(const FString& NodeName, const FString& CacheKey) const
+{
+	const FString* StoredKey = Data.NodeKeys.Find(NodeName);
+	return StoredKey && *StoredKey == CacheKey;
+}
+
+void FAutomationGraphResultCache::Store(const FString& NodeName, const FString& CacheKey)
+{
+	FString& StoredKey = Data.NodeKeys.FindOrAdd(NodeName);
+	if (StoredKey != CacheKey)
+	{
+		StoredKey = CacheKey;
+		bDirty = true;
+	}
+}
+
+void FAutomationGraphResultCache::Remove(const FString& NodeName)
+{
+	if (Data.NodeKeys.Remove(NodeName) > 0)
+	{
+		bDirty = true;
+	}
+}
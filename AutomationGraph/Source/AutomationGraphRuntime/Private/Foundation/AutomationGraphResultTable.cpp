@@ -0,0 +1,82 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Foundation/AutomationGraphResultTable.h"
+
+#include "Foundation/AutomationGraphNode.h"
+
+FInstancedStruct& FAutomationGraphResultTable::FindOrAddOutput(const UAutomationGraphNode* Node, FName SlotName, const UScriptStruct* Type)
+{
+	const FOutputKey Key(Node, SlotName);
+	if (const int32* ValueIndex = ValueIndices.Find(Key))
+	{
+		FInstancedStruct& Value = Values[*ValueIndex];
+		if (Value.GetScriptStruct() != Type)
+		{
+			Value.InitializeAs(Type);
+		}
+		return Value;
+	}
+
+	int32 ValueIndex = FreeIndices.IsEmpty() ? Values.AddDefaulted() : FreeIndices.Pop(EAllowShrinking::No);
+	ValueIndices.Add(Key, ValueIndex);
+	
+	FInstancedStruct& Value = Values[ValueIndex];
+	Value.InitializeAs(Type);
+	return Value;
+}
+
+const FInstancedStruct* FAutomationGraphResultTable::FindOutput(const UAutomationGraphNode* Node, FName SlotName) const
+{
+	const int32* ValueIndex = ValueIndices.Find(FOutputKey(Node, SlotName));
+	return ValueIndex ? &Values[*ValueIndex] : nullptr;
+}
+
+void FAutomationGraphResultTable::RemoveOutputs(const UAutomationGraphNode* Node)
+{
+	const TObjectKey<UAutomationGraphNode> NodeKey(Node);
+	for (auto It = ValueIndices.CreateIterator(); It; ++It)
+	{
+		if (It->Key.Key == NodeKey)
+		{
+			Values[It->Value].Reset();
+			FreeIndices.Add(It->Value);
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FAutomationGraphResultTable::Reset()
+{
+	Values.Empty();
+	ValueIndices.Empty();
+	FreeIndices.Empty();
+}
@@ -0,0 +1,171 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Foundation/AutomationGraphSchedule.h"
+
+bool FAutomationGraphCronExpression::Parse(const FString& Expression, FAutomationGraphCronExpression& OutCron, FString& OutError)
+{
+	TArray<FString> Fields;
+	Expression.ParseIntoArrayWS(Fields);
+	if (Fields.Num() != 5)
+	{
+		OutError = FString::Printf(TEXT("Expected 5 fields but found %d."), Fields.Num());
+		return false;
+	}
+
+	FAutomationGraphCronExpression Cron;
+	if (!ParseField(Fields[0], 0, 59, Cron.Minutes)
+		|| !ParseField(Fields[1], 0, 23, Cron.Hours)
+		|| !ParseField(Fields[2], 1, 31, Cron.DaysOfMonth)
+		|| !ParseField(Fields[3], 1, 12, Cron.Months)
+		|| !ParseField(Fields[4], 0, 7, Cron.DaysOfWeek))
+	{
+		OutError = FString::Printf(TEXT("Invalid field in \"%s\"."), *Expression);
+		return false;
+	}
+
+	// 7 is an alias for Sunday.
+	if (Cron.DaysOfWeek[7])
+	{
+		Cron.DaysOfWeek[0] = true;
+	}
+	
+	Cron.bAnyDayOfMonth = Fields[2].StartsWith(TEXT("*"));
+	Cron.bAnyDayOfWeek = Fields[4].StartsWith(TEXT("*"));
+	OutCron = MoveTemp(Cron);
+	return true;
+}
+
+FDateTime FAutomationGraphCronExpression::GetNextTime(const FDateTime& After) const
+{
+	FDateTime Time = FDateTime(After.GetYear(), After.GetMonth(), After.GetDay(), After.GetHour(), After.GetMinute()) + FTimespan::FromMinutes(1);
+	const FDateTime SearchLimit = Time + FTimespan::FromDays(366 * 5);
+	
+	while (Time < SearchLimit)
+	{
+		if (!Months[Time.GetMonth()])
+		{
+			Time = Time.GetMonth() == 12 ? FDateTime(Time.GetYear() + 1, 1, 1) : FDateTime(Time.GetYear(), Time.GetMonth() + 1, 1);
+			continue;
+		}
+		if (!MatchesDay(Time))
+		{
+			Time = Time.GetDate() + FTimespan::FromDays(1);
+			continue;
+		}
+		if (!Hours[Time.GetHour()])
+		{
+			Time = Time.GetDate() + FTimespan::FromHours(Time.GetHour() + 1);
+			continue;
+		}
+		if (!Minutes[Time.GetMinute()])
+		{
+			Time += FTimespan::FromMinutes(1);
+			continue;
+		}
+
+		return Time;
+	}
+
+	return FDateTime::MaxValue();
+}
+
+bool FAutomationGraphCronExpression::ParseField(const FString& Field, int32 MinValue, int32 MaxValue, TBitArray<>& OutValues)
+{
+	OutValues.Init(false, MaxValue + 1);
+	
+	TArray<FString> Parts;
+	Field.ParseIntoArray(Parts, TEXT(","));
+	if (Parts.IsEmpty())
+	{
+		return false;
+	}
+
+	for (const FString& Part : Parts)
+	{
+		FString Range = Part;
+		int32 Step = 1;
+
+		FString StepText;
+		if (Part.Split(TEXT("/"), &Range, &StepText))
+		{
+			if (!StepText.IsNumeric() || (Step = FCString::Atoi(*StepText)) <= 0)
+			{
+				return false;
+			}
+		}
+
+		int32 First = MinValue;
+		int32 Last = MaxValue;
+		if (Range != TEXT("*"))
+		{
+			FString FirstText = Range;
+			FString LastText;
+			const bool bIsRange = Range.Split(TEXT("-"), &FirstText, &LastText);
+			if (!FirstText.IsNumeric() || (bIsRange && !LastText.IsNumeric()))
+			{
+				return false;
+			}
+			
+			First = FCString::Atoi(*FirstText);
+			
+			// "5/15" means "from 5 to the end, every 15".
+			Last = bIsRange ? FCString::Atoi(*LastText) : (StepText.IsEmpty() ? First : MaxValue);
+		}
+
+		if (First < MinValue || Last > MaxValue || First > Last)
+		{
+			return false;
+		}
+
+		for (int32 Value = First; Value <= Last; Value += Step)
+		{
+			OutValues[Value] = true;
+		}
+	}
+
+	return true;
+}
+
+bool FAutomationGraphCronExpression::MatchesDay(const FDateTime& Time) const
+{
+	// EDayOfWeek starts on Monday, cron starts on Sunday.
+	const int32 DayOfWeek = (static_cast<int32>(Time.GetDayOfWeek()) + 1) % 7;
+	const bool bDayOfMonthMatches = DaysOfMonth[Time.GetDay()];
+	const bool bDayOfWeekMatches = DaysOfWeek[DayOfWeek];
+
+	if (!bAnyDayOfMonth && !bAnyDayOfWeek)
+	{
+		return bDayOfMonthMatches || bDayOfWeekMatches;
+	}
+	
+	return bDayOfMonthMatches && bDayOfWeekMatches;
+}
@@ -35,7 +35,11 @@
 #include "ClearLandscapeLayers.generated.h"
 
 class ALandscape;
+class ULandscapeLayerInfoObject;
 
+// Clears paint layers on the given edit layers of every landscape in the world, including all of their loaded streaming
+// proxies. Components that have nothing painted on a layer are skipped, and each landscape gets a single weightmap
+// update once everything has been cleared.
 UCLASS(meta=( DisplayName="Clear Landscape Layers" ))
 class AUTOMATIONGRAPHRUNTIME_API UAGN_ClearLandscapeLayers : public UCoreAutomationGraphNode
 {
@@ -59,7 +63,10 @@ protected:
 	//~UAutomationGraphNode interface.
 	virtual EAutomationGraphNodeState ActivateInternal(float DeltaSeconds) override;
 	//~End UAutomationGraphNode interface.
+
+	// Returns the number of components that had something to clear.
+	int32 ClearLandscape(ALandscape& Landscape, const TArray<int32>& EditLayerIndices, const TArray<ULandscapeLayerInfoObject*>& LayerInfos);
 	
 	UPROPERTY()
-	TWeakObjectPtr<ALandscape> TargetLandscape;
+	TArray<TWeakObjectPtr<ALandscape>> TargetLandscapes;
 };
@@ -34,6 +34,19 @@
 
 #include "ConsoleCommand.generated.h"
 
+UENUM()
+enum class EAutomationGraphCommandWorlds : uint8
+{
+	// The world the graph is running in.
+	GraphWorld,
+
+	// Every editor and PIE world that is currently open.
+	AllOpenWorlds,
+
+	// The worlds in the node's Worlds list. Worlds that aren't loaded count as failures.
+	ListedWorlds
+};
+
 UCLASS(Abstract)
 class AUTOMATIONGRAPHRUNTIME_API UAGN_ConsoleCommandBase : public UCoreAutomationGraphNode
 {
@@ -69,4 +82,46 @@ protected:
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FString Command;
+};
+
+// Runs a list of console commands, in order, in a single activation. Unlike Console Command, the node starts and finishes
+// in the same frame, so a chain of cvar and flush commands doesn't cost a frame or two per command.
+UCLASS(meta=( DisplayName="Batch Console Command" ))
+class AUTOMATIONGRAPHRUNTIME_API UAGN_BatchConsoleCommand : public UAGN_ConsoleCommandBase
+{
+	GENERATED_BODY()
+
+public:
+	UAGN_BatchConsoleCommand(const FObjectInitializer& Initializer);
+
+	//~UAutomationGraphNode interface.
+	virtual void GetOutputSlots(TArray<FAutomationGraphDataSlot>& OutSlots) override;
+	//~End UAutomationGraphNode interface.
+
+	// Commands that failed, as "<Command> (<World>)".
+	static const FName FailedCommandsOutputName;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> Commands;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EAutomationGraphCommandWorlds TargetWorlds = EAutomationGraphCommandWorlds::GraphWorld;
+
+	// Only used with ListedWorlds.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<TSoftObjectPtr<UWorld>> Worlds;
+
+	// Skip the remaining commands after the first failure. Either way, the node ends in the Error state if any command
+	// failed.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bStopOnFailure = false;
+	
+protected:
+	//~UAutomationGraphNode interface.
+	virtual FText GetNodeCategory() override { return FAutomationGraphNodeCategory::Util; }
+	virtual EAutomationGraphNodeState ActivateInternal(float DeltaSeconds) override;
+	//~End UAutomationGraphNode interface.
+
+	// Adds a failure for each requested world that couldn't be found.
+	void GetCommandWorlds(TArray<UWorld*>& OutWorlds, TArray<FString>& OutFailures) const;
 };
\ No newline at end of file
@@ -0,0 +1,114 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Foundation/AutomationGraphNode.h"
+#include "HAL/PlatformProcess.h"
+
+#include "RunProcess.generated.h"
+
+// Runs an external program (UAT, Python, a DCC tool) without blocking the editor. Its stdout and stderr are logged line
+// by line as they arrive, and its exit code decides the state the node finishes in.
+//
+// The number of processes running at once, across every graph, is limited by AutomationGraph.MaxProcessJobs. Nodes
+// wait in the Active state until a job slot is free. Time spent waiting doesn't count toward NodeTimeoutSec, which is
+// unlimited by default since builds and cooks can easily run for hours.
+UCLASS(meta=( DisplayName="Run Process" ))
+class AUTOMATIONGRAPHRUNTIME_API UAGN_RunProcess : public UCoreAutomationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UAGN_RunProcess(const FObjectInitializer& Initializer);
+
+	//~UObject interface
+	virtual void BeginDestroy() override;
+	//~End UObject interface
+
+	//~UAutomationGraphNode interface.
+	virtual FText GetNodeCategory() override { return FAutomationGraphNodeCategory::Util; }
+	virtual bool Initialize(UWorld* World) override;
+	virtual void Cleanup() override;
+	virtual void GetOutputSlots(TArray<FAutomationGraphDataSlot>& OutSlots) override;
+	virtual FString GetMessageText() override;
+	//~End UAutomationGraphNode interface.
+
+	// Lines the process wrote to stdout.
+	static const FName OutputLinesOutputName;
+
+	// Relative paths are relative to the project directory. A bare program name is looked up on the PATH.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString Executable;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString Arguments;
+
+	// Defaults to the project directory.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString WorkingDirectory;
+
+	// The state to finish in for specific exit codes. Other exit codes finish the node if they are 0, and put it into
+	// the Error state otherwise.
+	UPROPERTY(EditAnywhere)
+	TMap<int32, EAutomationGraphNodeState> ExitCodeStates;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bLogOutput = true;
+
+protected:
+	//~UAutomationGraphNode interface.
+	virtual EAutomationGraphNodeState ActivateInternal(float DeltaSeconds) override;
+	virtual bool IsTimeoutRunning() const override { return Process.IsValid(); }
+	//~End UAutomationGraphNode interface.
+
+	bool AcquireJobSlot();
+	bool LaunchProcess();
+	void ReleaseProcess();
+
+	// Reads whatever is waiting in the pipes and handles every complete line. With bFlush, a trailing partial line is
+	// handled as well.
+	void ReadPipes(bool bFlush);
+	void ReadPipe(void* Pipe, FString& PendingText, bool bStdErr, bool bFlush);
+	void HandleLine(FString Line, bool bStdErr);
+	
+	EAutomationGraphNodeState GetExitState(int32 ExitCode) const;
+
+	FProcHandle Process;
+	void* StdOutRead = nullptr;
+	void* StdOutWrite = nullptr;
+	void* StdErrRead = nullptr;
+	void* StdErrWrite = nullptr;
+
+	FString PendingStdOut;
+	FString PendingStdErr;
+	TArray<FString> OutputLines;
+	bool bHasJobSlot = false;
+};
@@ -0,0 +1,72 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Foundation/AutomationGraphStructNode.h"
+
+#include "StructNodes.generated.h"
+
+// Struct node equivalent of UAGN_Wait.
+USTRUCT(meta=( DisplayName="Wait" ))
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphStructNode_Wait : public FAutomationGraphStructNode
+{
+	GENERATED_BODY()
+
+public:
+	virtual EAutomationGraphNodeState Activate(float DeltaSeconds, float ElapsedSec) override;
+
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0"))
+	double WaitTimeSec = 0.0;
+};
+
+// Struct node equivalent of UAGN_SyntheticWork.
+USTRUCT(meta=( DisplayName="Synthetic Work" ))
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphStructNode_SyntheticWork : public FAutomationGraphStructNode
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool Initialize(UWorld* World) override;
+	virtual EAutomationGraphNodeState Activate(float DeltaSeconds, float ElapsedSec) override;
+	
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0"))
+	float DurationSec = 0.0f;
+
+	// Probability [0, 1] that this node ends in the Error state instead of Finished.
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0", ClampMax="1.0"))
+	float FailureRate = 0.0f;
+
+	UPROPERTY(EditAnywhere)
+	int32 RandomSeed = 0;
+
+private:
+	FRandomStream RandomStream;
+};
@@ -0,0 +1,83 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Foundation/AutomationGraphNode.h"
+
+#include "Subgraph.generated.h"
+
+class UAutomationGraph;
+class UAutomationGraphExecutor;
+
+// Runs another graph as a single step of this one. Each use of the subgraph runs its own copy of the referenced graph's
+// nodes, created from a plan that is compiled once and shared by every use. The subgraph's nodes are ticked alongside
+// the rest of the parent graph, so they run in parallel with any other active nodes.
+//
+// The subgraph runs as if it had been started with the Run button: only roots that respond to OnPlay are started.
+UCLASS(meta=( DisplayName="Subgraph" ))
+class AUTOMATIONGRAPHRUNTIME_API UAGN_Subgraph : public UCoreAutomationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UAGN_Subgraph(const FObjectInitializer& Initializer);
+
+	//~UAutomationGraphNode interface.
+	virtual FText GetNodeCategory() override { return FAutomationGraphNodeCategory::Util; }
+	virtual bool Initialize(UWorld* World) override;
+	virtual void Cleanup() override;
+	virtual FString GetMessageText() override;
+	//~End UAutomationGraphNode interface.
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TObjectPtr<UAutomationGraph> Graph;
+
+protected:
+	//~UAutomationGraphNode interface.
+	virtual EAutomationGraphNodeState ActivateInternal(float DeltaSeconds) override;
+	virtual void CancelInternal() override;
+	//~End UAutomationGraphNode interface.
+
+	bool StartSubgraph();
+
+	// True if running SearchGraph would eventually run a graph on Path again. Path holds the graphs currently being run,
+	// outermost first, and is left holding the cycle when one is found. Graphs in Finished are known to be cycle-free.
+	static bool FindCycle(UAutomationGraph* SearchGraph, TArray<const UAutomationGraph*>& Path, TSet<const UAutomationGraph*>& Finished);
+
+	UPROPERTY()
+	TWeakObjectPtr<UWorld> TargetWorld;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UAutomationGraph> GraphInstance;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UAutomationGraphExecutor> SubgraphExecutor;
+};
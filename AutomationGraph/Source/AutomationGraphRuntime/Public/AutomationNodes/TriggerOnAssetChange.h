@@ -0,0 +1,92 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Foundation/AutomationGraphNode.h"
+
+#include "TriggerOnAssetChange.generated.h"
+
+// Runs the graph when matching assets are saved, imported, or reimported. Changes are collected until there haven't
+// been any for DebounceSec, so a Save All triggers one run rather than one per package. The changed assets are written
+// to the ChangedAssets output.
+//
+// Autosaves, saves of automation graphs, and saves made while cooking are ignored.
+UCLASS(meta=( DisplayName="Trigger On Asset Change" ))
+class AUTOMATIONGRAPHRUNTIME_API UAGN_TriggerOnAssetChange : public UCoreAutomationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UAGN_TriggerOnAssetChange(const FObjectInitializer& Initializer);
+
+	//~UAutomationGraphNode interface.
+	virtual FText GetNodeCategory() override { return FAutomationGraphNodeCategory::Triggers; }
+	virtual TArray<EAutomationGraphNodeTrigger> GetTriggers() override;
+	virtual void GetOutputSlots(TArray<FAutomationGraphDataSlot>& OutSlots) override;
+	//~End UAutomationGraphNode interface
+
+	// True if the asset passes the path and class filters.
+	bool MatchesAsset(const UObject* Asset) const;
+
+	// Adds assets to the batch that the next activation writes to ChangedAssets.
+	void AddChangedAssets(const TArray<FSoftObjectPath>& Assets);
+
+	static const FName ChangedAssetsOutputName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bTriggerOnSave = true;
+
+	// Covers both new imports and reimports.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bTriggerOnImport = true;
+
+	// Wildcards matched against the asset's package name, e.g. "/Game/Environment/*".
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> PathFilters = {TEXT("/Game/*")};
+
+	// If not empty, only assets of these classes (or their subclasses) trigger the graph.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<TSubclassOf<UObject>> ClassFilters;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0.0"))
+	float DebounceSec = 1.0f;
+
+	// If true, this node will also trigger when you click the play button.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bTriggerOnPlay = false;
+
+protected:
+	//~UAutomationGraphNode interface.
+	virtual EAutomationGraphNodeState ActivateInternal(float DeltaSeconds) override;
+	//~End UAutomationGraphNode interface.
+
+	TArray<FSoftObjectPath> PendingAssets;
+};
@@ -0,0 +1,97 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Engine/EngineTypes.h"
+#include "Foundation/AutomationGraphNode.h"
+
+#include "TriggerOnFileChange.generated.h"
+
+// Runs the graph when files in any of the watched directories change. Bursts of changes (a sync, an export that writes
+// many files) are collected until there haven't been any for DebounceSec, and then trigger a single run. The changed
+// files are written to the ChangedFiles output as absolute paths.
+//
+// Watches are registered by the editor subsystem for every graph that is loaded at startup, and refreshed when the
+// graph is saved.
+UCLASS(meta=( DisplayName="Trigger On File Change" ))
+class AUTOMATIONGRAPHRUNTIME_API UAGN_TriggerOnFileChange : public UCoreAutomationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UAGN_TriggerOnFileChange(const FObjectInitializer& Initializer);
+
+	//~UAutomationGraphNode interface.
+	virtual FText GetNodeCategory() override { return FAutomationGraphNodeCategory::Triggers; }
+	virtual TArray<EAutomationGraphNodeTrigger> GetTriggers() override;
+	virtual void GetOutputSlots(TArray<FAutomationGraphDataSlot>& OutSlots) override;
+	//~End UAutomationGraphNode interface
+
+	// Absolute paths of the watched directories.
+	TArray<FString> GetWatchedDirectories() const;
+
+	// True if the file, given relative to the watched directory, passes the include and exclude filters.
+	bool MatchesFilters(const FString& RelativePath) const;
+
+	// Adds files to the batch that the next activation writes to ChangedFiles.
+	void AddChangedFiles(const TArray<FString>& Files);
+
+	static const FName ChangedFilesOutputName;
+
+	// Relative paths are relative to the project directory.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FDirectoryPath> Directories;
+
+	// Wildcards matched against each file's path relative to the watched directory, e.g. "*.fbx" or "Textures/*".
+	// A file must match at least one include filter and no exclude filter.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> IncludeFilters = {TEXT("*")};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> ExcludeFilters;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bIncludeSubdirectories = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0.0"))
+	float DebounceSec = 1.0f;
+
+	// If true, this node will also trigger when you click the play button.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bTriggerOnPlay = false;
+
+protected:
+	//~UAutomationGraphNode interface.
+	virtual EAutomationGraphNodeState ActivateInternal(float DeltaSeconds) override;
+	//~End UAutomationGraphNode interface.
+
+	TArray<FString> PendingFiles;
+};
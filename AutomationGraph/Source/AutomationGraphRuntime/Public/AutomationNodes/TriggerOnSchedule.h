@@ -0,0 +1,85 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Foundation/AutomationGraphNode.h"
+
+#include "TriggerOnSchedule.generated.h"
+
+UENUM()
+enum class EAutomationGraphScheduleType : uint8
+{
+	// Every IntervalMinutes, starting when the editor loads the graph.
+	Interval,
+
+	// Whenever CronExpression matches, in local time. See FAutomationGraphCronExpression.
+	Cron
+};
+
+// Runs the graph on a schedule, e.g. every night at 02:00 or every 15 minutes while the editor is idle. If the graph is
+// still running when the next run comes due, the runs are coalesced into a single queued run rather than piling up.
+UCLASS(meta=( DisplayName="Trigger On Schedule" ))
+class AUTOMATIONGRAPHRUNTIME_API UAGN_TriggerOnSchedule : public UCoreAutomationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UAGN_TriggerOnSchedule(const FObjectInitializer& Initializer);
+
+	//~UAutomationGraphNode interface.
+	virtual FText GetNodeCategory() override { return FAutomationGraphNodeCategory::Triggers; }
+	virtual TArray<EAutomationGraphNodeTrigger> GetTriggers() override;
+	//~End UAutomationGraphNode interface
+
+	// The first run time strictly after the given local time. FDateTime::MaxValue() if the schedule is invalid.
+	FDateTime GetNextRunTime(const FDateTime& After) const;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EAutomationGraphScheduleType ScheduleType = EAutomationGraphScheduleType::Interval;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="1.0", EditCondition="ScheduleType == EAutomationGraphScheduleType::Interval", EditConditionHides))
+	float IntervalMinutes = 15.0f;
+
+	// minute hour day-of-month month day-of-week
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(EditCondition="ScheduleType == EAutomationGraphScheduleType::Cron", EditConditionHides))
+	FString CronExpression = TEXT("0 2 * * *");
+
+	// If true, a run that comes due while the user is working is delayed until there has been no input for IdleSec.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bOnlyWhenIdle = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0.0", EditCondition="bOnlyWhenIdle"))
+	float IdleSec = 300.0f;
+
+	// If true, this node will also trigger when you click the play button.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bTriggerOnPlay = false;
+};
@@ -0,0 +1,169 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "AutomationGraphBenchmark.generated.h"
+
+class UWorld;
+
+UENUM()
+enum class EAutomationGraphBenchmarkShape: uint8
+{
+	Chain,
+	FanOut,
+	FanIn,
+	Diamond,
+	RandomDAG
+};
+
+USTRUCT()
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphBenchmarkSettings
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	int32 MinNodes = 10;
+
+	// Graph sizes go from MinNodes to MaxNodes in powers of 10.
+	UPROPERTY()
+	int32 MaxNodes = 100000;
+
+	// Simulated frame time passed to UAutomationGraphExecutor::Execute().
+	UPROPERTY()
+	float DeltaSeconds = 1.0f / 60.0f;
+
+	UPROPERTY()
+	float NodeDurationSec = 0.0f;
+
+	UPROPERTY()
+	float NodeFailureRate = 0.0f;
+
+	UPROPERTY()
+	int32 RandomSeed = 1337;
+
+	// Total time (build + start + execute) allowed for all sizes of one shape. Each size is ten times the last, so a size
+	// is skipped, along with every larger one, if ten times the previous size's time wouldn't fit in what is left. Keeps
+	// quadratic behavior from hanging the editor.
+	UPROPERTY()
+	float ShapeBudgetSec = 30.0f;
+
+	UPROPERTY()
+	int32 MaxTicks = 1000000;
+};
+
+USTRUCT()
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphBenchmarkResult
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	EAutomationGraphBenchmarkShape Shape = EAutomationGraphBenchmarkShape::Chain;
+
+	UPROPERTY()
+	int32 NodeCount = 0;
+
+	UPROPERTY()
+	int32 EdgeCount = 0;
+
+	UPROPERTY()
+	bool bSkipped = false;
+
+	UPROPERTY()
+	double BuildSec = 0.0;
+
+	UPROPERTY()
+	double StartExecutionSec = 0.0;
+
+	UPROPERTY()
+	int32 TickCount = 0;
+
+	UPROPERTY()
+	double TotalExecuteSec = 0.0;
+
+	UPROPERTY()
+	double AvgExecuteSec = 0.0;
+
+	UPROPERTY()
+	double MaxExecuteSec = 0.0;
+
+	// Number of UObjects created while building the graph, and while starting execution.
+	UPROPERTY()
+	int32 BuildObjectCount = 0;
+
+	UPROPERTY()
+	int32 StartExecutionObjectCount = 0;
+
+	// Memory owned by the graph and its nodes after building, and how much that (plus the executor) grew while starting
+	// execution. Counted with FArchiveCountMem, so this only covers reflected properties and the containers they own.
+	UPROPERTY()
+	int64 BuildMemoryBytes = 0;
+
+	UPROPERTY()
+	int64 StartExecutionMemoryBytes = 0;
+
+	UPROPERTY()
+	int32 FinishedNodes = 0;
+
+	UPROPERTY()
+	int32 FailedNodes = 0;
+};
+
+USTRUCT()
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphBenchmarkReport
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	FDateTime Timestamp;
+
+	UPROPERTY()
+	FAutomationGraphBenchmarkSettings Settings;
+
+	UPROPERTY()
+	TArray<FAutomationGraphBenchmarkResult> Results;
+};
+
+// Builds synthetic graphs of UAGN_SyntheticWork nodes and measures the cost of the executor on them.
+//
+// Run through the automation tests under AutomationGraph.Benchmark (Perf filter). See AutomationGraphBenchmarkTest.cpp.
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphBenchmark
+{
+	// Runs every shape. Results are appended to OutReport.
+	static void Run(UWorld* World, const FAutomationGraphBenchmarkSettings& Settings, FAutomationGraphBenchmarkReport& OutReport);
+	static void Run(UWorld* World, const FAutomationGraphBenchmarkSettings& Settings, EAutomationGraphBenchmarkShape Shape, FAutomationGraphBenchmarkReport& OutReport);
+	static bool RunShape(UWorld* World, const FAutomationGraphBenchmarkSettings& Settings, EAutomationGraphBenchmarkShape Shape, int32 NodeCount, FAutomationGraphBenchmarkResult& OutResult);
+	static bool WriteReport(const FAutomationGraphBenchmarkReport& Report, const FString& OutputFilePath);
+	static FString GetDefaultReportPath(EAutomationGraphBenchmarkShape Shape);
+};
@@ -31,11 +31,31 @@
 
 #pragma once
 #include "AutomationGraphNode.h"
+#include "InstancedStruct.h"
 
 #include "AutomationGraph.generated.h"
 
+class UAutomationGraph;
 class UAutomationGraphExecutor;
 
+// A graph (or one node in it) that must finish before the owning graph may start. While the prerequisite is queued or
+// running, the owning graph waits for it. Otherwise its most recent result in this editor session decides: a failed or
+// cancelled run skips the owning graph, and a prerequisite that hasn't run yet doesn't hold anything up.
+USTRUCT()
+struct FAutomationGraphDependency
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = "Dependencies")
+	TSoftObjectPtr<UAutomationGraph> Graph;
+
+	// Object name or title of a node in Graph. A title must be unique within the graph. If empty, the whole graph must
+	// finish.
+	UPROPERTY(EditAnywhere, Category = "Dependencies")
+	FString NodeName;
+};
+
 UCLASS()
 class AUTOMATIONGRAPHRUNTIME_API UAutomationGraph : public UObject
 {
@@ -46,11 +66,71 @@ public:
 	virtual bool IsNodeSupported(TSubclassOf<UAutomationGraphNode> NodeType);
 	virtual void UninitializeNodes();
 	virtual void CancelNodes();
+
+	// True if any root node (object or struct) responds to the given trigger.
+	bool HasRootTrigger(EAutomationGraphNodeTrigger Trigger);
+
+	// Finds a node by its object name or, failing that, its title. Returns null (and logs an error) if more than one node
+	// has the title.
+	UAutomationGraphNode* FindNode(const FString& NodeName) const;
+
+	// The asset this graph was made from. Subgraph instances are transient copies, so this returns the graph they were
+	// instantiated from. Any other graph returns itself.
+	UAutomationGraph* GetSourceGraph() { return SourceGraph ? SourceGraph.Get() : this; }
+
+	//~UObject interface
+#if WITH_EDITOR
+	virtual void PostLoad() override;
+#endif
+	//~End UObject interface
 	
 	UPROPERTY()
 	TArray<TObjectPtr<UAutomationGraphNode>> RootNodes;
 
-	// In the editor, this object is responsible for configuring the node structure and updating RootNodes.
+	// Lightweight nodes for very large generated graphs. Each entry holds an FAutomationGraphStructNode (or subtype),
+	// and StructEdges connects them by index. These run alongside RootNodes but are not shown in the editor graph.
+	UPROPERTY(meta=(BaseStruct="/Script/AutomationGraphRuntime.AutomationGraphStructNode"))
+	TArray<FInstancedStruct> StructNodes;
+
+	UPROPERTY()
+	TArray<FAutomationGraphEdge> StructEdges;
+
+	// If true, every run of this graph appends a record (node states, durations, trigger) to the on-disk history
+	// store. See FAutomationGraphHistory.
+	UPROPERTY(EditAnywhere, Category = "History")
+	bool bRecordExecutionHistory = true;
+
+	// If true, nodes that support result caching are skipped when their inputs haven't changed since their last
+	// successful run. See UAutomationGraphNode::GatherCacheInputs().
+	UPROPERTY(EditAnywhere, Category = "Caching")
+	bool bUseResultCache = true;
+
+	// The subsystem won't start this graph until every dependency has finished successfully. If a dependency fails,
+	// the queued run is dropped.
+	UPROPERTY(EditAnywhere, Category = "Dependencies")
+	TArray<FAutomationGraphDependency> Dependencies;
+
+	// What happens to the files in the artifact store when a run ends. See FAutomationGraphArtifactStore.
+	UPROPERTY(EditAnywhere, Category = "Artifacts")
+	EAutomationGraphArtifactRetention ArtifactRetention = EAutomationGraphArtifactRetention::KeepUntilNextRun;
+
+#if WITH_EDITORONLY_DATA
+	// In the editor, this object is responsible for configuring the node structure and updating RootNodes. It is only
+	// the visual representation, so it is created as a transient object when the asset is opened and is never saved.
+	// Loading a graph to run it doesn't deserialize any editor nodes, edges or pins.
 	UPROPERTY()
 	TObjectPtr<UEdGraph> EditorGraph;
+
+	// Where each node sits in the editor graph. Written when the asset is saved and read back when the editor graph is
+	// rebuilt.
+	UPROPERTY()
+	TMap<TObjectPtr<UAutomationGraphNode>, FIntPoint> EditorNodePositions;
+#endif
+
+private:
+	friend struct FAutomationGraphPlan;
+
+	// Set on instances created by FAutomationGraphPlan::Instantiate. See GetSourceGraph().
+	UPROPERTY(Transient)
+	TObjectPtr<UAutomationGraph> SourceGraph;
 };
\ No newline at end of file
@@ -0,0 +1,54 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "AutomationGraphTypes.h"
+
+// Flattened child lists for a graph whose nodes are addressed by index. The children of node N are
+// Children[ChildOffsets[N] .. ChildOffsets[N + 1]).
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphAdjacency
+{
+	TArray<int32> ChildOffsets;
+	TArray<int32> Children;
+	TArray<int32> ParentCounts;
+
+	// Validates the edges and builds the child lists in O(nodes + edges). Duplicate edges are dropped with a warning.
+	// Fails if an edge is out of range, connects a node to itself, or if the edges form a cycle.
+	bool Build(int32 NodeCount, TConstArrayView<FAutomationGraphEdge> Edges, FString& OutError);
+	void Reset();
+
+	int32 NumNodes() const { return ParentCounts.Num(); }
+	
+	TConstArrayView<int32> GetChildren(int32 NodeIndex) const
+	{
+		return MakeArrayView(Children.GetData() + ChildOffsets[NodeIndex], ChildOffsets[NodeIndex + 1] - ChildOffsets[NodeIndex]);
+	}
+};
@@ -0,0 +1,119 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "UObject/ObjectKey.h"
+
+#include "AutomationGraphArtifactStore.generated.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+class UAutomationGraphNode;
+
+UENUM()
+enum class EAutomationGraphArtifactRetention : uint8
+{
+	// Artifacts are kept after the run, so they can be inspected and reused by partial runs. They are deleted when the
+	// graph next runs in full.
+	KeepUntilNextRun,
+
+	// Same as KeepUntilNextRun if the run failed, otherwise artifacts are deleted as soon as the run ends.
+	KeepIfFailed,
+	
+	DeleteWhenRunEnds
+};
+
+// Read-only, memory-mapped view of an artifact. The mapping is released when the last reference to the view goes away.
+class AUTOMATIONGRAPHRUNTIME_API FAutomationGraphArtifactView
+{
+public:
+	~FAutomationGraphArtifactView();
+	
+	TConstArrayView64<uint8> GetData() const { return Data; }
+	int64 Num() const { return Data.Num(); }
+
+private:
+	friend class FAutomationGraphArtifactStore;
+
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TConstArrayView64<uint8> Data;
+};
+
+// Run-scoped store for large intermediate outputs (heightmaps, exported meshes, reports). Producers publish named
+// artifacts, which are written once to a per-graph directory under Saved/AutomationGraph/Artifacts. Consumers map them
+// read-only instead of loading a copy. What happens to the artifacts at the end of a run depends on the graph's
+// EAutomationGraphArtifactRetention.
+//
+// For small, typed results, use the result table instead. See UAutomationGraphNode::WriteOutput().
+class AUTOMATIONGRAPHRUNTIME_API FAutomationGraphArtifactStore
+{
+public:
+	static FString GetStoreDirectory(const FString& GraphPath);
+
+	// If bKeepArtifacts is false, any artifacts left over from a previous run are deleted.
+	void BeginRun(const FString& GraphPath, bool bKeepArtifacts);
+	void EndRun(EAutomationGraphArtifactRetention Retention, bool bRunSucceeded);
+
+	// Forgets about the current artifacts without touching the files on disk.
+	void Reset();
+
+	// Artifact names are unique for the run and are also used as the file name, so include an extension if external
+	// tools will read the file. Each producer writes to its own subdirectory. Fails if another node (or this one) has
+	// already published an artifact with the same name.
+	bool PublishArtifact(const UAutomationGraphNode* Producer, FName Name, TConstArrayView64<uint8> Data);
+
+	// Moves a file that was written by something else (an external process, an exporter) into the store.
+	bool PublishArtifactFile(const UAutomationGraphNode* Producer, FName Name, const FString& SourceFilePath);
+	
+	TSharedPtr<FAutomationGraphArtifactView> MapArtifact(FName Name) const;
+	bool HasArtifact(FName Name) const { return Artifacts.Contains(Name); }
+	FString GetArtifactFilePath(FName Name) const;
+
+	// Names of the artifacts published by the given node, in no particular order.
+	void GetArtifacts(const UAutomationGraphNode* Producer, TArray<FName>& OutNames) const;
+
+	// Deletes every artifact published by the given node. Used when the node is about to run again.
+	void RemoveArtifacts(const UAutomationGraphNode* Producer);
+
+private:
+	struct FArtifact
+	{
+		TObjectKey<UAutomationGraphNode> Producer;
+		FString FilePath;
+	};
+
+	bool AddArtifact(const UAutomationGraphNode* Producer, FName Name, FString& OutFilePath);
+	void DeleteStoreDirectory();
+	
+	FString StoreDirectory;
+	TMap<FName, FArtifact> Artifacts;
+};
@@ -0,0 +1,108 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "AutomationGraph.h"
+#include "AutomationGraphStructNode.h"
+
+class UAutomationGraphNode;
+
+// Builds the runtime node structure of a UAutomationGraph directly, without an editor graph. This is the fast path for
+// generating large graphs from data (one node per map, per test shard, etc).
+//
+// Nodes and edges are staged in the builder and nothing on the graph changes until Build() is called. Build() validates
+// everything in a single pass (supported node types, duplicate nodes and edges, edge indices, cycles) and then replaces
+// the graph's nodes. Staged state is kept, so Build() can be called again after adding more. The graph's EditorGraph is
+// discarded and any asset editor showing the graph is closed; the editor regenerates it the next time the asset is
+// opened.
+//
+// For very large graphs, prefer struct nodes (AddStructNode) over object nodes. See FAutomationGraphStructNode.
+class AUTOMATIONGRAPHRUNTIME_API FAutomationGraphBuilder
+{
+public:
+	explicit FAutomationGraphBuilder(UAutomationGraph* InGraph);
+
+	void Reserve(int32 NumNodes, int32 NumEdges);
+
+	// Adds a node that was created with the builder's graph as its outer. Returns the node's index.
+	int32 AddNode(UAutomationGraphNode* Node);
+
+	template <typename NodeType>
+	NodeType* CreateNode(int32* OutNodeIndex = nullptr)
+	{
+		auto* Node = NewObject<NodeType>(Graph, NodeType::StaticClass(), NAME_None, RF_Transactional);
+		int32 NodeIndex = AddNode(Node);
+		if (OutNodeIndex)
+		{
+			*OutNodeIndex = NodeIndex;
+		}
+		return Node;
+	}
+
+	UAutomationGraphNode* CreateNode(TSubclassOf<UAutomationGraphNode> NodeClass, int32* OutNodeIndex = nullptr);
+
+	void AddEdge(int32 ParentIndex, int32 ChildIndex);
+	void AddEdges(TConstArrayView<FAutomationGraphEdge> NewEdges);
+
+	// Struct nodes have their own index space and can only be connected to other struct nodes.
+	template <typename StructNodeType>
+	int32 AddStructNode(const StructNodeType& StructNode)
+	{
+		static_assert(TIsDerivedFrom<StructNodeType, FAutomationGraphStructNode>::Value, "StructNodeType must derive from FAutomationGraphStructNode");
+		return StructNodes.Add(FInstancedStruct::Make(StructNode));
+	}
+
+	void AddStructEdge(int32 ParentIndex, int32 ChildIndex);
+	void AddStructEdges(TConstArrayView<FAutomationGraphEdge> NewEdges);
+
+	UAutomationGraphNode* GetNode(int32 NodeIndex) const { return Nodes.IsValidIndex(NodeIndex) ? Nodes[NodeIndex] : nullptr; }
+	int32 NumNodes() const { return Nodes.Num(); }
+	int32 NumStructNodes() const { return StructNodes.Num(); }
+	UAutomationGraph* GetGraph() const { return Graph; }
+
+	// Validates the staged nodes and edges and writes them to the graph. On failure, the graph is left untouched and
+	// OutError describes the first problem found.
+	bool Build(FString& OutError);
+
+#if WITH_EDITOR
+	// Broadcast by Build() once validation has passed and before the graph's nodes are replaced. The editor module uses
+	// it to close asset editors showing the graph, since their editor graph is about to be discarded.
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnGraphRebuilding, UAutomationGraph*);
+	static FOnGraphRebuilding OnGraphRebuilding;
+#endif
+
+private:
+	UAutomationGraph* Graph = nullptr;
+	TArray<UAutomationGraphNode*> Nodes;
+	TArray<FAutomationGraphEdge> Edges;
+	TArray<FInstancedStruct> StructNodes;
+	TArray<FAutomationGraphEdge> StructEdges;
+};
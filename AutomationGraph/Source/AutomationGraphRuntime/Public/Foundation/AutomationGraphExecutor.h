@@ -30,9 +30,15 @@
 // ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
+#include "AutomationGraphAdjacency.h"
+#include "AutomationGraphArtifactStore.h"
+#include "AutomationGraphHistory.h"
+#include "AutomationGraphResultCache.h"
+#include "AutomationGraphResultTable.h"
 
 #include "AutomationGraphExecutor.generated.h"
 
+struct FAutomationGraphStructNode;
 struct FGraphExecutionTask;
 class UAutomationGraphNode;
 class UAutomationGraph;
@@ -49,15 +55,84 @@ public:
 	virtual bool Execute(float DeltaSeconds);
 	virtual void Cancel(UAutomationGraph* Graph);
 
+	// State of a struct node in the current (or most recent) run. See UAutomationGraph::StructNodes.
+	EAutomationGraphNodeState GetStructNodeState(int32 NodeIndex) const;
+
+	UAutomationGraph* GetTargetGraph() const { return TargetGraph.Get(); }
+	bool IsRunning() const { return !ActiveNodes.IsEmpty() || !ActiveStructNodes.IsEmpty(); }
+
+	// True if every node in the most recent run finished successfully.
+	bool DidLastRunSucceed() const { return bLastRunSucceeded; }
+
+	// Outputs written by nodes during the current (or most recent) run.
+	const FAutomationGraphResultTable& GetResultTable() const { return ResultTable; }
+
 protected:
 	virtual void PreInitializeNodes(UWorld* World) {}
 	virtual bool InitializeNode(UAutomationGraphNode* Node, UWorld* World);
 	virtual void PostInitializeNodes() {}
+
+	// Restricts the run to the downstream closure of the dirty nodes. Every other node is finished with its previous
+	// result. Returns false if there is nothing to run.
+	virtual bool ApplyDirtySubgraph(const TSet<UAutomationGraphNode*>& DirtyNodes);
+
+	// Checks that every required input of every node has an upstream output with a matching name and type.
+	virtual bool ValidateDataSlots();
 	virtual void Reset();
+	virtual void RecordExecutionHistory();
+
+	// Called once when a run finishes or is cancelled.
+	virtual void EndRun(bool bRunSucceeded);
+
+	// Computes the node's cache key and, if it matches the node's last successful run, finishes the node. Returns true
+	// if the node was finished from the cache.
+	virtual bool TryFinishFromCache(UAutomationGraphNode* Node);
+	void UpdateResultCache(UAutomationGraphNode* Node);
+
+	// Hash of what a node that isn't cacheable produced this run (its outputs and artifacts, plus the keys of its own
+	// parents). This is what its children's cache keys are built from in place of a cache key.
+	FString MakeResultKey(UAutomationGraphNode* Node) const;
+
+	// Struct nodes are run natively by index. Their run state lives in the arrays below rather than on the nodes.
+	virtual bool StartStructExecution(const FGraphExecutionTask& ExecutionTask);
+	virtual void ExecuteStructNodes(float DeltaSeconds);
+	virtual void CancelStructNodes();
+	void SetStructNodeState(int32 NodeIndex, EAutomationGraphNodeState NewState);
 	
 	TWeakObjectPtr<UAutomationGraph> TargetGraph;
 	TSet<TWeakObjectPtr<UAutomationGraphNode>> ActiveNodes;
 
+	// Every node that was initialized for the current run, in initialization order. Used to build the run record.
+	TArray<TWeakObjectPtr<UAutomationGraphNode>> ExecutionNodes;
+	FAutomationGraphRunRecord CurrentRunRecord;
+	bool bRecordingRun = false;
+
+	bool bUseResultCache = false;
+	FAutomationGraphResultCache ResultCache;
+	TMap<TWeakObjectPtr<UAutomationGraphNode>, FString> NodeCacheKeys;
+
+	// Result keys of finished nodes that aren't cacheable. See MakeResultKey().
+	TMap<TWeakObjectPtr<UAutomationGraphNode>, FString> NodeResultKeys;
+
+	// Nodes that were explicitly marked dirty for this run. These never use the result cache.
+	TSet<TWeakObjectPtr<UAutomationGraphNode>> ForcedNodes;
+
+	UPROPERTY()
+	FAutomationGraphResultTable ResultTable;
+
+	FAutomationGraphArtifactStore ArtifactStore;
+	bool bLastRunSucceeded = false;
+
+	// Pointers into TargetGraph->StructNodes. Only valid while TargetGraph is valid.
+	TArray<FAutomationGraphStructNode*> StructNodes;
+	FAutomationGraphAdjacency StructAdjacency;
+	TArray<EAutomationGraphNodeState> StructNodeStates;
+	TArray<float> StructNodeElapsedSec;
+	TArray<int32> StructNodeRemainingParents;
+	TArray<int32> ActiveStructNodes;
+	TArray<FDateTime> StructNodeStartTimes;
+	TArray<FDateTime> StructNodeEndTimes;
+
 	float TickRateSec = 0.0f;
 	float ExecutionTimer = 0.0f;
 };
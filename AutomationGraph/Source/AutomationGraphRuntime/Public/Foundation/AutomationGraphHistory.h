@@ -0,0 +1,114 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "AutomationGraphTypes.h"
+
+#include "AutomationGraphHistory.generated.h"
+
+class UAutomationGraph;
+
+USTRUCT()
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphNodeRunRecord
+{
+	GENERATED_BODY()
+
+public:
+	// Object name of the node. This is stable across runs, unlike the title which the user can edit.
+	UPROPERTY()
+	FString NodeName;
+
+	UPROPERTY()
+	FString NodeClass;
+
+	UPROPERTY()
+	FString Title;
+
+	UPROPERTY()
+	EAutomationGraphNodeState State = EAutomationGraphNodeState::Uninitialized;
+
+	// Seconds between the start of the run and the node becoming active. Negative if the node never became active.
+	UPROPERTY()
+	float StartOffsetSec = -1.0f;
+
+	UPROPERTY()
+	float DurationSec = 0.0f;
+
+	// True if the node was finished from the result cache instead of running.
+	UPROPERTY()
+	bool bCached = false;
+
+	// True if the node was outside the re-run part of a partial run and kept its result from the previous run.
+	UPROPERTY()
+	bool bReused = false;
+};
+
+USTRUCT()
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphRunRecord
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	FString GraphPath;
+
+	UPROPERTY()
+	EAutomationGraphNodeTrigger Trigger = EAutomationGraphNodeTrigger::Unknown;
+
+	UPROPERTY()
+	FDateTime StartTime;
+
+	UPROPERTY()
+	FDateTime EndTime;
+
+	UPROPERTY()
+	TArray<FAutomationGraphNodeRunRecord> Nodes;
+};
+
+// On-disk execution history. Each graph gets its own file under Saved/AutomationGraph/History, and every run appends
+// a single line of condensed json to it.
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphHistory
+{
+	static FString GetHistoryFilePath(const FString& GraphPath);
+	static FString GetHistoryFilePath(UAutomationGraph* Graph);
+
+	static bool AppendRunRecord(const FAutomationGraphRunRecord& Record);
+
+	// Loads at most MaxRuns of the most recent records (oldest first). MaxRuns <= 0 loads everything.
+	static bool LoadRunRecords(const FString& GraphPath, TArray<FAutomationGraphRunRecord>& OutRecords, int32 MaxRuns = 0);
+
+	// Average duration of each node (keyed by NodeName) over the given runs. Only nodes that finished (and were not
+	// cached) are counted.
+	static void GetAverageNodeDurations(const TArray<FAutomationGraphRunRecord>& Records, TMap<FString, float>& OutDurations);
+
+	// Writes the records out in the Chrome trace event format, which can be opened in chrome://tracing or Perfetto.
+	static bool ExportChromeTrace(const TArray<FAutomationGraphRunRecord>& Records, const FString& OutputFilePath);
+};
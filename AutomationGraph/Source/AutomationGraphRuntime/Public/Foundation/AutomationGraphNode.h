@@ -31,10 +31,14 @@
 
 #pragma once
 #include "AutomationGraphRuntimeConstants.h"
+#include "AutomationGraphArtifactStore.h"
+#include "AutomationGraphResultTable.h"
 #include "AutomationGraphTypes.h"
 
 #include "AutomationGraphNode.generated.h"
 
+struct FAutomationGraphCacheInputs;
+
 UCLASS(Abstract)
 class AUTOMATIONGRAPHRUNTIME_API UAutomationGraphNode : public UObject
 {
@@ -61,7 +65,40 @@ public:
 
 	bool GetElapsedTime(float& OutElapsedTime);
 
+	// Wall-clock times of the current (or most recent) activation. Both are zero until the node becomes active, and
+	// EndTime stays zero until the node reaches a finished state.
+	FDateTime GetActivationStartTime() const { return ActivationStartTime; }
+	FDateTime GetActivationEndTime() const { return ActivationEndTime; }
+
 	virtual FText GetNodeCategory() { return FAutomationGraphNodeCategory::Default; }
+
+	// Nodes whose result depends only on their inputs can opt in to result caching by adding those inputs (property
+	// values, referenced assets and files) and returning true. The executor also mixes in the cache keys of the node's
+	// parents; a parent that isn't cacheable contributes a hash of the outputs it produced this run instead. If the key
+	// matches the node's last successful run, the node is finished without activating.
+	virtual bool GatherCacheInputs(FAutomationGraphCacheInputs& Inputs) { return false; }
+
+	// Moves a node in standby straight to Finished. Used by the executor when the node's result is cached.
+	void FinishFromCache();
+	bool IsFinishedFromCache() const { return bFinishedFromCache; }
+
+	// Moves a node in standby straight to Finished, keeping its outputs and artifacts from the previous run. Used by the
+	// executor for nodes outside the dirty subgraph of a partial run. This is separate from the result cache: the node
+	// hasn't been checked against its inputs, it just wasn't affected by the edit.
+	void FinishWithPreviousResult();
+	bool IsReusingPreviousResult() const { return bReusingPreviousResult; }
+
+	// Typed data passed between nodes. Outputs are written to the executor's result table during activation, and inputs
+	// are read from the nearest upstream node that has an output of the same name (or the name given in InputSources).
+	// Nodes with outputs are never finished from the result cache, since their outputs are not persisted.
+	virtual void GetInputSlots(TArray<FAutomationGraphDataSlot>& OutSlots) {}
+	virtual void GetOutputSlots(TArray<FAutomationGraphDataSlot>& OutSlots) {}
+
+	// The name of the upstream output that the given input reads from.
+	FName GetInputSource(FName InputName) const;
+	
+	void SetResultTable(FAutomationGraphResultTable* InResultTable) { ResultTable = InResultTable; }
+	void SetArtifactStore(FAutomationGraphArtifactStore* InArtifactStore) { ArtifactStore = InArtifactStore; }
 	
 	// Text to push out to the UI.
 	virtual FString GetMessageText();
@@ -79,16 +116,54 @@ public:
 	UPROPERTY()
 	FText Title;
 
+	// Upstream output names to read inputs from, keyed by input name, for when the output has a different name than
+	// the input. For example, mapping Tests to FailedTests makes a Run Tests node rerun the tests that failed in an
+	// upstream Run Tests node. Inputs not listed here read the output with their own name.
+	UPROPERTY(EditAnywhere)
+	TMap<FName, FName> InputSources;
+
 protected:
 	virtual EAutomationGraphNodeState ActivateInternal(float DeltaSeconds);
 	virtual void CancelInternal() {}
 	EAutomationGraphNodeState SetState(EAutomationGraphNodeState NodeState);
 
+	// Active time only counts toward NodeTimeoutSec while this returns true. Nodes that wait on a shared resource before
+	// they start their actual work can return false until they have it.
+	virtual bool IsTimeoutRunning() const { return true; }
+
+	// Returns the output for this run, creating it if it doesn't exist yet. Null if the node isn't being executed.
+	template <typename DataType>
+	DataType* WriteOutput(FName SlotName)
+	{
+		return ResultTable ? ResultTable->FindOrAddOutput(this, SlotName, DataType::StaticStruct()).GetMutablePtr<DataType>() : nullptr;
+	}
+
+	// Returns the nearest upstream output for the given input, or null if there isn't one or it has the wrong type.
+	template <typename DataType>
+	const DataType* ReadInput(FName SlotName)
+	{
+		const FInstancedStruct* Value = FindInput(SlotName);
+		return Value ? Value->GetPtr<DataType>() : nullptr;
+	}
+	
+	const FInstancedStruct* FindInput(FName SlotName);
+
+	// Large outputs that are better kept out of memory. See FAutomationGraphArtifactStore.
+	bool PublishArtifact(FName Name, TConstArrayView64<uint8> Data);
+	bool PublishArtifactFile(FName Name, const FString& SourceFilePath);
+	TSharedPtr<FAutomationGraphArtifactView> MapArtifact(FName Name) const;
+
 	float NodeTimeoutSec = 300.0f; // 5m
 
 private:
 	EAutomationGraphNodeState NodeState = EAutomationGraphNodeState::Uninitialized;
 	float TimeElapsedSec = 0.0f;
+	FDateTime ActivationStartTime;
+	FDateTime ActivationEndTime;
+	bool bFinishedFromCache = false;
+	bool bReusingPreviousResult = false;
+	FAutomationGraphResultTable* ResultTable = nullptr;
+	FAutomationGraphArtifactStore* ArtifactStore = nullptr;
 };
 
 // Used to distinguish "official" nodes defined by this plugin.
@@ -0,0 +1,59 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "AutomationGraphAdjacency.h"
+
+class UAutomationGraph;
+class UAutomationGraphNode;
+
+// A validated, flattened copy of a graph's node structure. Plans are compiled once per graph asset and shared by every
+// user of that graph (see UAGN_Subgraph). In the editor, a graph's plan is recompiled after the graph or any of its
+// nodes is modified.
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphPlan
+{
+	// Returns the cached plan for the graph, compiling it if needed. Returns null and sets OutError if the graph is
+	// invalid (for example, if it contains a cycle).
+	static TSharedPtr<const FAutomationGraphPlan> Get(UAutomationGraph* Graph, FString& OutError);
+	static void Invalidate(const UAutomationGraph* Graph);
+
+	// Creates a private, transient copy of the graph that can be executed without touching the asset's own nodes.
+	UAutomationGraph* Instantiate(UObject* Outer) const;
+
+	TWeakObjectPtr<UAutomationGraph> Graph;
+	
+	// Every node reachable from the graph's roots. Adjacency is indexed the same way.
+	TArray<TWeakObjectPtr<UAutomationGraphNode>> Nodes;
+	FAutomationGraphAdjacency Adjacency;
+
+private:
+	bool Compile(UAutomationGraph* InGraph, FString& OutError);
+};
@@ -0,0 +1,107 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Misc/SecureHash.h"
+
+#include "AutomationGraphResultCache.generated.h"
+
+class UAutomationGraphNode;
+struct FInstancedStruct;
+
+// Collects everything a cacheable node's result depends on and hashes it into a single cache key. See
+// UAutomationGraphNode::GatherCacheInputs().
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphCacheInputs
+{
+	void AddString(FStringView Value);
+
+	// Hashes the exported text of every non-transient property declared below StopAtClass. By default this is all of
+	// the properties added by a node subclass, but not the node links or title.
+	void AddProperties(const UObject* Object, const UClass* StopAtClass = nullptr);
+
+	// Hashes the type and exported text of a struct value, such as a node output.
+	void AddStruct(const FInstancedStruct& Value);
+
+	// Hashes the contents of a file. Missing files are hashed as missing, so creating the file invalidates the key.
+	void AddFile(const FString& FilePath);
+
+	// Hashes the package file of an asset on disk. If the package is loaded with unsaved changes, the inputs are
+	// invalidated since the saved file no longer describes the asset.
+	void AddAsset(const FSoftObjectPath& AssetPath);
+
+	// Marks the inputs as unknown. The node will not be cached for this run.
+	void Invalidate(const FString& Reason);
+	
+	bool IsValid() const { return bValid; }
+	const FString& GetInvalidReason() const { return InvalidReason; }
+
+	// Finishes the hash and returns it as a hex string. Do not add any more inputs after calling this.
+	FString Finalize();
+
+private:
+	FSHA1 Hasher;
+	bool bValid = true;
+	FString InvalidReason;
+};
+
+USTRUCT()
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphResultCacheData
+{
+	GENERATED_BODY()
+
+public:
+	// Node name -> cache key of the node's last successful run.
+	UPROPERTY()
+	TMap<FString, FString> NodeKeys;
+};
+
+// Persistent record of the inputs each cacheable node last finished with. Each graph gets its own file under
+// Saved/AutomationGraph/Cache.
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphResultCache
+{
+	static FString GetCacheFilePath(const FString& GraphPath);
+
+	// Loads the cache for the given graph. A missing cache file is not an error, the cache just starts out empty.
+	void Load(const FString& InGraphPath);
+
+	// Writes the cache back to disk if anything has changed since it was loaded.
+	bool Save();
+	void Reset();
+
+	bool Contains(const FString& NodeName, const FString& CacheKey) const;
+	void Store(const FString& NodeName, const FString& CacheKey);
+	void Remove(const FString& NodeName);
+
+private:
+	FString GraphPath;
+	FAutomationGraphResultCacheData Data;
+	bool bDirty = false;
+};
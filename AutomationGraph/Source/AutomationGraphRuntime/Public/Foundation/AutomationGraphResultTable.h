@@ -0,0 +1,100 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "InstancedStruct.h"
+#include "UObject/ObjectKey.h"
+
+#include "AutomationGraphResultTable.generated.h"
+
+class UAutomationGraphNode;
+
+// Declares a typed input or output of a node. Inputs are matched to the outputs of upstream nodes by name, and the
+// output's type must be the same as (or derive from) the input's type.
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphDataSlot
+{
+	FAutomationGraphDataSlot(FName InName, const UScriptStruct* InType, bool bInRequired = false)
+		: Name(InName), Type(InType), bRequired(bInRequired) {}
+	
+	FName Name;
+	const UScriptStruct* Type = nullptr;
+
+	// Only meaningful for inputs. The executor refuses to start a graph if a required input has no matching output.
+	bool bRequired = false;
+};
+
+// Common data types for passing results between nodes.
+USTRUCT(BlueprintType)
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphStringList
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Automation Graph")
+	TArray<FString> Values;
+};
+
+USTRUCT(BlueprintType)
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphAssetList
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Automation Graph")
+	TArray<FSoftObjectPath> Assets;
+};
+
+// Per-run storage for node outputs, owned by the executor. The memory of each value is allocated separately, so the
+// pointers nodes get from WriteOutput() and ReadInput() stay valid until the output is removed or the table is reset.
+// This lets downstream nodes read results by reference rather than copying them.
+USTRUCT()
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphResultTable
+{
+	GENERATED_BODY()
+
+public:
+	// Returns the output, creating it if needed. If the output already exists with a different type, it is replaced.
+	FInstancedStruct& FindOrAddOutput(const UAutomationGraphNode* Node, FName SlotName, const UScriptStruct* Type);
+	const FInstancedStruct* FindOutput(const UAutomationGraphNode* Node, FName SlotName) const;
+	
+	void RemoveOutputs(const UAutomationGraphNode* Node);
+	void Reset();
+
+private:
+	using FOutputKey = TPair<TObjectKey<UAutomationGraphNode>, FName>;
+
+	// A UPROPERTY so that any object references inside the outputs are seen by the garbage collector.
+	UPROPERTY()
+	TArray<FInstancedStruct> Values;
+
+	TMap<FOutputKey, int32> ValueIndices;
+	TArray<int32> FreeIndices;
+};
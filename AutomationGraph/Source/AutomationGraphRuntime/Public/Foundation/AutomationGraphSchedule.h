@@ -0,0 +1,59 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+// A parsed five-field cron expression: "minute hour day-of-month month day-of-week". Each field accepts "*", single
+// values, ranges ("1-5"), steps ("*/15", "0-30/10"), and comma-separated lists of these. Day-of-week runs from 0
+// (Sunday) to 6, and 7 is also Sunday. As in standard cron, if both day fields are restricted, a day matching either one
+// matches.
+//
+// For example, "0 2 * * *" is every night at 02:00 and "*/15 9-17 * * 1-5" is every 15 minutes during working hours.
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphCronExpression
+{
+	static bool Parse(const FString& Expression, FAutomationGraphCronExpression& OutCron, FString& OutError);
+
+	// The first matching minute strictly after the given time, or FDateTime::MaxValue() if there is none in the next
+	// few years (e.g. "0 0 31 2 *").
+	FDateTime GetNextTime(const FDateTime& After) const;
+
+private:
+	static bool ParseField(const FString& Field, int32 MinValue, int32 MaxValue, TBitArray<>& OutValues);
+	bool MatchesDay(const FDateTime& Time) const;
+	
+	TBitArray<> Minutes;
+	TBitArray<> Hours;
+	TBitArray<> DaysOfMonth;
+	TBitArray<> Months;
+	TBitArray<> DaysOfWeek;
+	bool bAnyDayOfMonth = true;
+	bool bAnyDayOfWeek = true;
+};
@@ -0,0 +1,73 @@
+﻿// Copyright © Mason Stevenson
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the disclaimer
+// below) provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+// THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+// NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "AutomationGraphTypes.h"
+
+#include "AutomationGraphStructNode.generated.h"
+
+class UWorld;
+
+// Lightweight alternative to UAutomationGraphNode for very large generated graphs. Struct nodes are stored by value in
+// UAutomationGraph::StructNodes and are connected by index (UAutomationGraph::StructEdges). They have no per-node
+// UObject overhead and their run state (node state, elapsed time, etc) is owned by the executor instead of the node.
+//
+// Struct nodes are not shown in the editor graph. Use FAutomationGraphBuilder to create them.
+USTRUCT()
+struct AUTOMATIONGRAPHRUNTIME_API FAutomationGraphStructNode
+{
+	GENERATED_BODY()
+
+public:
+	virtual ~FAutomationGraphStructNode() = default;
+
+	// Returning false puts the node in the Error state.
+	virtual bool Initialize(UWorld* World) { return true; }
+
+	// Called every tick while the node is active, starting on the tick it becomes active. ElapsedSec is the time since
+	// the node became active. Return Active to keep running, or one of the finished states.
+	virtual EAutomationGraphNodeState Activate(float DeltaSeconds, float ElapsedSec) { return EAutomationGraphNodeState::Finished; }
+
+	// Called when an active or standby node is cancelled.
+	virtual void Cancel() {}
+
+	// Called once the node has reached a finished state. See UAutomationGraphNode::Cleanup().
+	virtual void Cleanup() {}
+
+	// Only checked for nodes without parents.
+	virtual bool HasTrigger(EAutomationGraphNodeTrigger Trigger) const { return Trigger == EAutomationGraphNodeTrigger::OnPlay; }
+
+	UPROPERTY(EditAnywhere)
+	FString Title;
+
+	UPROPERTY(EditAnywhere)
+	float NodeTimeoutSec = 300.0f; // 5m
+};
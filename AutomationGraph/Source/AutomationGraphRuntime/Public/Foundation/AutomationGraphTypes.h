@@ -34,6 +34,7 @@
 #include "AutomationGraphTypes.generated.h"
 
 class UAutomationGraph;
+class UAutomationGraphNode;
 class UWorld;
 
 UENUM()
@@ -58,7 +59,27 @@ enum class EAutomationGraphNodeTrigger: uint8
 {
 	Unknown,
 	OnPlay,
-	OnStartup
+	OnStartup,
+	OnFileChange,
+	OnAssetChange,
+	OnSchedule
+};
+
+// A directed edge between two nodes, stored as indices into a node array.
+USTRUCT()
+struct FAutomationGraphEdge
+{
+	GENERATED_BODY()
+
+public:
+	FAutomationGraphEdge() = default;
+	FAutomationGraphEdge(int32 InParentIndex, int32 InChildIndex): ParentIndex(InParentIndex), ChildIndex(InChildIndex) {}
+	
+	UPROPERTY()
+	int32 ParentIndex = INDEX_NONE;
+
+	UPROPERTY()
+	int32 ChildIndex = INDEX_NONE;
 };
 
 USTRUCT()
@@ -70,4 +91,25 @@ public:
 	TWeakObjectPtr<UAutomationGraph> TargetGraph = nullptr;
 	TWeakObjectPtr<UWorld> TargetWorld = nullptr;
 	EAutomationGraphNodeTrigger Trigger = EAutomationGraphNodeTrigger::Unknown;
+
+	// If not empty, only these nodes and their descendants are run. Every other node that finished in the previous run
+	// keeps that result instead of running again.
+	TArray<TWeakObjectPtr<UAutomationGraphNode>> DirtyNodes;
+
+	// Triggers of other runs that were merged into this one while it was queued. Roots that respond to any of these are
+	// started along with the roots for Trigger.
+	TArray<EAutomationGraphNodeTrigger> MergedTriggers;
+
+	void MergeTrigger(EAutomationGraphNodeTrigger NewTrigger)
+	{
+		if (NewTrigger != Trigger)
+		{
+			MergedTriggers.AddUnique(NewTrigger);
+		}
+	}
+	
+	bool HasTrigger(EAutomationGraphNodeTrigger NodeTrigger) const
+	{
+		return NodeTrigger == Trigger || MergedTriggers.Contains(NodeTrigger);
+	}
 };
\ No newline at end of file